@@ -44,6 +44,10 @@ namespace Assets {
 	/// White texture.
 	Tex white;
 
+	/// Rainbow color texture.
+	/// @note Stays bound to texture unit 1.
+	Tex hue;
+
 	/// Rainbow color array.
 	glm::vec3 rainbow[6][256];
 
@@ -117,5 +121,9 @@ namespace Assets {
 		font   .set(Mid::font   , GL_TEXTURE0, GL_NEAREST);
 		rank   .set(Mid::rank   , GL_TEXTURE0, GL_NEAREST);
 		white  .set(Mid::white  , GL_TEXTURE0, GL_NEAREST);
+
+		// bind rainbow texture to its own unit
+		hue.set(Mid::rainbow, GL_TEXTURE1, GL_NEAREST);
+		GLState::bindTexture(1, hue.ID);
 	};
 };
\ No newline at end of file
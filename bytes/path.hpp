@@ -37,6 +37,54 @@ namespace Bytes {
 			Log::out.print();
 			return *this;
 		};
+
+		/// Parse event from a recorder line.
+		/// @param line Event line (`<event type="eastdown" time="12"/>`).
+		/// @return Whether the line contained a valid event.
+		/// @note Time may be written as `seconds!ticks`.
+		bool parse(const char* line) {
+			static const char* types[9] {
+				"eastup", "westup", "northup", "southup",
+				"eastdown", "westdown", "northdown", "southdown",
+				"sync"
+			};
+
+			// find event type
+			const char* attr = strstr(line, "type=\"");
+			if (attr == NULL) return false;
+			attr += 6;
+
+			// decode event type
+			int type = -1;
+			for (int i = 0; i < 9; i++) {
+				size_t len = strlen(types[i]);
+				if (strncmp(attr, types[i], len) == 0 && attr[len] == '"') {
+					type = i;
+					break;
+				};
+			};
+			if (type < 0) return false;
+
+			// set event data
+			dir = static_cast<Direction>(type & 3);
+			key = type >> 2 & 1;
+			sync = type == 8;
+			time = 0;
+			moving = 0;
+			waypoint = 0;
+
+			// read event parameters
+			if (sync) {
+				if ((attr = strstr(line, "moving=\"")))   moving   = (uint16_t)atoi(attr + 8);
+				if ((attr = strstr(line, "waypoint=\""))) waypoint = (uint16_t)atoi(attr + 10);
+			} else if ((attr = strstr(line, "time=\""))) {
+				char* end;
+				long value = strtol(attr + 6, &end, 10);
+				if (*end == '!') value = value * 240 + strtol(end + 1, NULL, 10);
+				time = (uint16_t)value;
+			};
+			return true;
+		};
 	};
 
 	/// Cube input path object.
@@ -62,5 +110,19 @@ namespace Bytes {
 			};
 			return *this;
 		};
+
+		/// Parse path from a recorder stream.
+		/// @param input Input stream.
+		/// @return Self-reference.
+		/// @note Lines without events are ignored.
+		Path& parse(FILE* input) {
+			char line[256];
+			while (fgets(line, sizeof(line), input)) {
+				Event evt;
+				if (evt.parse(line))
+					evts.push_back(evt);
+			};
+			return *this;
+		};
 	};
 };
\ No newline at end of file
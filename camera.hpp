@@ -10,6 +10,48 @@ struct CameraTarget {
 	float time;
 };
 
+/// View frustum object.
+struct Frustum {
+	/// Frustum clipping planes.
+	/// @note Plane normals point inside the frustum.
+	glm::vec4 planes[6];
+
+	/// Extracts frustum planes from a camera matrix.
+	/// @param mat Projection & view matrix.
+	Frustum (const glm::mat4& mat) {
+		glm::vec4 w = row(mat, 3);
+		for (int i = 0; i < 3; i++) {
+			planes[i * 2 + 0] = w + row(mat, i);
+			planes[i * 2 + 1] = w - row(mat, i);
+		};
+	};
+
+	/// Returns a matrix row.
+	/// @param mat Source matrix.
+	/// @param i Row index.
+	static glm::vec4 row(const glm::mat4& mat, int i) {
+		return glm::vec4(mat[0][i], mat[1][i], mat[2][i], mat[3][i]);
+	};
+
+	/// Checks whether a box is at least partially inside of the frustum.
+	/// @param min Box minimum coordinates.
+	/// @param max Box maximum coordinates.
+	/// @note Boxes near frustum corners may be reported as visible.
+	bool visible(glm::vec3 min, glm::vec3 max) const {
+		for (const glm::vec4& p : planes) {
+			// test box corner furthest along plane normal
+			glm::vec3 v = glm::vec3(
+				p.x >= 0.0f ? max.x : min.x,
+				p.y >= 0.0f ? max.y : min.y,
+				p.z >= 0.0f ? max.z : min.z
+			);
+			if (p.x * v.x + p.y * v.y + p.z * v.z + p.w < 0.0f)
+				return false;
+		};
+		return true;
+	};
+};
+
 /// Camera object.
 struct Camera {
 	/// Camera position.
@@ -190,12 +232,11 @@ struct Camera {
 		return sf::IntRect(min, max - min);
 	};
 
-	/// Updates matrix uniform.
-	/// @param shader Shader program.
-	/// @param name Uniform name.
-	void uniform(Shader& shader, const char* name) {
-		shader.use();
-		glm::mat4 mat = proj * view;
-		glUniformMatrix4fv(glGetUniformLocation(shader.ID, name), 1, GL_FALSE, glm::value_ptr(mat));
+	/// Returns camera view frustum.
+	Frustum frustum() const { return Frustum(proj * view); };
+
+	/// Sends camera matrix to shaders.
+	void uniform() {
+		Shaders::sendCamera(proj * view);
 	};
 };
\ No newline at end of file
@@ -18,6 +18,10 @@ namespace Debug {
 	size_t vert_normal = 0;
 	size_t vert_shadow = 0;
 
+	// terrain face merging
+	size_t terrain_faces = 0;
+	size_t terrain_quads = 0;
+
 	/// Updates FPS measuring stats.
 	void updateFPS() {
 		if (updateClock.getElapsedTime().asMilliseconds() >= 250) {
@@ -69,10 +73,16 @@ namespace Debug {
 			profile->setFmt(
 				"\2Uptime\4:\r \6%02llu\7 : \6%02llu\7 : \6%02llu\7\n"
 				"\6%.1f\7 FPS \4|\r \6%.1f\7 ms\n"
-				"\6%llu\7Q \4|\r \6%llu\7S \4|\r \6%llu\7F",
+				"\6%llu\7Q \4|\r \6%llu\7S \4|\r \6%llu\7F\n"
+				"\6%llu\7 GL \4|\r \6%llu\7 skipped\n"
+				"\6%llu\7 draws \4|\r \6%llu\7 shaders \4|\r \6%llu\7 textures\n"
+				"\6%llu\7 faces \4|\r \6%llu\7 terrain quads",
 				h, m, s,
 				FPS, ms,
-				vert_normal / 6, vert_shadow / 6, UI::sprite_count
+				vert_normal / 6, vert_shadow / 6, UI::sprite_count,
+				GLState::issued, GLState::skipped,
+				RenderQueue::draws, RenderQueue::shaders, RenderQueue::textures,
+				terrain_faces, terrain_quads
 			);
 		});
 		screen.add(profile);
@@ -0,0 +1,157 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Moving platform spatial index.
+	/// @note Platforms are bucketed into unit grid cells covered by their volumes.
+	/// @note Small platform lists are scanned linearly, as hashing costs more than it saves.
+	class Broadphase {
+		public:
+		/// Grid cell range object.
+		struct Range {
+			sf::Vector3i min; // Minimum cell coordinates.
+			sf::Vector3i max; // Maximum cell coordinates.
+
+			/// Checks if 2 ranges are equal.
+			bool operator==(const Range& oth) const { return min == oth.min && max == oth.max; };
+		};
+
+		/// Returns a grid cell key.
+		/// @param x Cell X coordinate.
+		/// @param y Cell Y coordinate.
+		/// @param z Cell Z coordinate.
+		static uint64_t key(int x, int y, int z) {
+			return (uint64_t)(x + 0x100000 & 0x1FFFFF)
+				| (uint64_t)(y + 0x100000 & 0x1FFFFF) << 21
+				| (uint64_t)(z + 0x100000 & 0x1FFFFF) << 42;
+		};
+
+		private:
+		/// Minimum platform count to use grid cells.
+		static constexpr size_t linear = 32;
+
+		/// Platform lists of each occupied grid cell.
+		std::unordered_map<uint64_t, std::vector<size_t>> cells;
+		/// Cached platform cell ranges.
+		std::vector<Range> ranges;
+
+		/// Query deduplication marks.
+		mutable std::vector<uint32_t> marks;
+		/// Current query mark.
+		mutable uint32_t stamp = 0;
+		/// Query result buffer.
+		mutable std::vector<size_t> result;
+
+		/// Returns grid cells covered by a volume.
+		/// @param vol Covering volume.
+		static Range range(const vol3x& vol) { return { vol.pos.int3(), vol.out().int3() }; };
+
+		/// Inserts a platform into grid cells.
+		/// @param idx Platform index.
+		/// @param r Covered cell range.
+		void insert(size_t idx, const Range& r) {
+			for (int z = r.min.z; z <= r.max.z; z++) {
+				for (int y = r.min.y; y <= r.max.y; y++) {
+					for (int x = r.min.x; x <= r.max.x; x++)
+						cells[key(x, y, z)].push_back(idx);
+				};
+			};
+		};
+
+		/// Removes a platform from grid cells.
+		/// @param idx Platform index.
+		/// @param r Covered cell range.
+		void erase(size_t idx, const Range& r) {
+			for (int z = r.min.z; z <= r.max.z; z++) {
+				for (int y = r.min.y; y <= r.max.y; y++) {
+					for (int x = r.min.x; x <= r.max.x; x++) {
+						auto it = cells.find(key(x, y, z));
+						if (it == cells.end()) continue;
+
+						// remove platform from cell list
+						std::vector<size_t>& list = it->second;
+						list.erase(std::find(list.begin(), list.end(), idx));
+						if (list.empty()) cells.erase(it);
+					};
+				};
+			};
+		};
+
+		public:
+		/// Rebuilds the index from scratch.
+		/// @param plats Moving platform list.
+		void build(const MovingPlats& plats) {
+			cells.clear();
+			ranges.clear();
+			marks.assign(plats.size(), stamp);
+			if (plats.size() < linear) {
+				ranges.resize(plats.size());
+				return;
+			};
+			for (size_t i = 0; i < plats.size(); i++) {
+				ranges.push_back(range(plats.volume(i)));
+				insert(i, ranges.back());
+			};
+		};
+
+		/// Moves platforms that changed grid cells.
+		/// @param plats Moving platform list.
+		void update(const MovingPlats& plats) {
+			if (plats.size() != ranges.size()) {
+				build(plats);
+				return;
+			};
+			if (plats.size() < linear) return;
+
+			// update cell ranges
+			for (size_t i = 0; i < plats.size(); i++) {
+				Range r = range(plats.volume(i));
+				if (r == ranges[i]) continue;
+				erase(i, ranges[i]);
+				insert(i, r);
+				ranges[i] = r;
+			};
+		};
+
+		/// Collects platforms that may intersect a volume.
+		/// @param vol Query volume.
+		/// @return Platform indices in ascending order.
+		/// @warning Result is invalidated by the next query.
+		const std::vector<size_t>& query(const vol3x& vol) const {
+			result.clear();
+
+			// return all platforms
+			if (ranges.size() < linear) {
+				for (size_t i = 0; i < ranges.size(); i++)
+					result.push_back(i);
+				return result;
+			};
+
+			// advance query mark
+			if (++stamp == 0) {
+				std::fill(marks.begin(), marks.end(), 0);
+				stamp = 1;
+			};
+
+			// collect platforms in covered cells
+			Range r = range(vol);
+			for (int z = r.min.z; z <= r.max.z; z++) {
+				for (int y = r.min.y; y <= r.max.y; y++) {
+					for (int x = r.min.x; x <= r.max.x; x++) {
+						auto it = cells.find(key(x, y, z));
+						if (it == cells.end()) continue;
+						for (size_t idx : it->second) {
+							if (marks[idx] == stamp) continue;
+							marks[idx] = stamp;
+							result.push_back(idx);
+						};
+					};
+				};
+			};
+
+			// keep platform order stable
+			std::sort(result.begin(), result.end());
+			return result;
+		};
+	};
+};
\ No newline at end of file
@@ -5,139 +5,184 @@ namespace Level {
 	// import model theme
 	using Models::Theme;
 
-	/// Bumper object.
-	struct Bumper {
+	/// Bumper list.
+	/// @note Simulation fields are stored in separate arrays, so per-tick kernels stream only over hot data.
+	/// @note Boolean fields are stored as bytes, since `std::vector<bool>` elements cannot be referenced.
+	struct Bumpers {
 		/// Bumper data.
-		const Bytes::Bumper* root;
+		std::vector<const Bytes::Bumper*> root;
 
-		/// Whether the bumper is active.
-		bool active;
-		/// Current animation time left.
-		float left;
-		/// Whether the bumper exerts impulse.
-		bool bumps;
-		/// Whether the bumper should be disabled after next bump.
-		bool disable;
+		std::vector<uint8_t>  active; // Whether bumpers are active.
+		std::vector<float>      left; // Current animation time left.
+		std::vector<uint8_t>   bumps; // Whether bumpers exert impulse.
+		std::vector<uint8_t> disable; // Whether bumpers should be disabled after next bump.
 
-		/// Bumper object.
-		Object* object = NULL;
+		/// Bumper models.
+		ModelList objects;
 
-		/// Destructor.
-		~Bumper () { if (object) delete object; };
+		/// Empty list constructor.
+		Bumpers () {};
+		/// Copy constructor.
+		/// @param bumpers Copied bumper list.
+		/// @note Copy will ignore models.
+		Bumpers (const Bumpers& bumpers):
+			root(bumpers.root), active(bumpers.active), left(bumpers.left),
+			bumps(bumpers.bumps), disable(bumpers.disable) {};
+		/// Move constructor.
+		/// @param bumpers Moved bumper list.
+		Bumpers (Bumpers&& bumpers) = default;
+		/// Copy assignment.
+		/// @param bumpers Copied bumper list.
+		/// @note Copy will ignore models, so assigned list keeps its own ones.
+		Bumpers& operator=(const Bumpers& bumpers) {
+			root = bumpers.root;
+			active = bumpers.active;
+			left = bumpers.left;
+			bumps = bumpers.bumps;
+			disable = bumpers.disable;
+			return *this;
+		};
+		/// Move assignment.
+		/// @param bumpers Moved bumper list.
+		Bumpers& operator=(Bumpers&& bumpers) = default;
+
+		/// Returns bumper count.
+		size_t size() const { return root.size(); };
 
-		/// Structure constructor.
+		/// Adds a bumper.
 		/// @param data Bumper data.
-		Bumper (const Bytes::Bumper* data): root(data) {
-			active = data->active;
-			left = convTicks(data->init);
-			object = NULL;
-			bumps = false;
-			disable = false;
+		void add(const Bytes::Bumper* data) {
+			root.push_back(data);
+			active.push_back(data->active);
+			left.push_back(convTicks(data->init));
+			bumps.push_back(false);
+			disable.push_back(false);
 		};
 
-		/// Copy constructor.
-		/// @param bumper Copied bumper object.
-		/// @note Copy will ignore model pointer.
-		Bumper (const Bumper& bumper):
-			root(bumper.root),
-			active(bumper.active),
-			left(bumper.left),
-			bumps(bumper.bumps),
-			disable(bumper.disable) {};
-
-		/// Copy assignment.
-		/// @param bumper Copied bumper object.
-		/// @note Copy will ignore model pointer.
-		Bumper& operator=(const Bumper& bumper) {
-			root = bumper.root;
-			active = bumper.active;
-			left = bumper.left;
-			bumps = bumper.bumps;
-			disable = bumper.disable;
-			return *this;
+		/// Copies bumper state from another list.
+		/// @param idx Bumper index.
+		/// @param src Source bumper list.
+		void copy(size_t idx, const Bumpers& src) {
+			active[idx] = src.active[idx];
+			left[idx] = src.left[idx];
+			bumps[idx] = src.bumps[idx];
+			disable[idx] = src.disable[idx];
 		};
 
-		/// Generates a bumper model.
+		/// Generates bumper models.
 		void model() {
-			delete object; object = new Object;
-			object->pos = root->pos.gl();
-			Models::Bumper::generate(*object, root->dir, root->theme, Textures::Terrain::shadeZ((int)root->pos.z));
+			objects.generate(size());
+			for (size_t i = 0; i < size(); i++) {
+				objects[i].pos = root[i]->pos.gl();
+				Models::Bumper::generate(objects[i], root[i]->dir, root[i]->theme, Textures::Terrain::shadeZ((int)root[i]->pos.z));
+			};
 		};
 
 		/// Triggers a bumper.
+		/// @param idx Bumper index.
 		/// @param act Bumper activation type.
-		void trigger(Bytes::Bumper::Activation act) {
+		void trigger(size_t idx, Bytes::Bumper::Activation act) {
 			switch (act) {
 				// disable the bumper
 				case Bytes::Bumper::Disable:
-					active = false;
+					active[idx] = false;
 					return;
 				// enable only once
 				case Bytes::Bumper::Once:
-					active = true;
-					disable = true;
-					left = 0.0f;
+					active[idx] = true;
+					disable[idx] = true;
+					left[idx] = 0.0f;
 					break;
 				// enable the bumper
 				case Bytes::Bumper::Enable:
-					active = true;
-					disable = false;
-					left = 0.0f;
+					active[idx] = true;
+					disable[idx] = false;
+					left[idx] = 0.0f;
 					return;
 			};
 		};
 
-		/// Update bumper state.
+		/// Visits bumper simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) {
+			for (size_t i = 0; i < size(); i++)
+				snap(active[i])(left[i])(bumps[i])(disable[i]);
+		};
+
+		/// Checks whether updates leave a bumper unchanged.
+		/// @param idx Bumper index.
+		bool idle(size_t idx) const { return left[idx] == 0.0f && !active[idx]; };
+
+		/// Returns bumper animation progress.
+		/// @param idx Bumper index.
+		float progress(size_t idx) const {
+			return glm::clamp((convTicks(root[idx]->time) - left[idx]) / convTicks(root[idx]->bump), 0.0f, 1.0f);
+		};
+
+		/// Updates bumper states.
 		/// @param delta Elapsed time since last frame.
-		void update(float delta) {
-			// update animation time
-			if (left > 0.0f) {
-				if (left < delta) left = 0.0f;
-				else left -= delta;
-				if (disable) {
-					active = false;
-					disable = false;
+		/// @param changes Changed bumper set.
+		void update(float delta, Dirty& changes) {
+			const size_t count = size();
+			for (size_t i = 0; i < count; i++) {
+				if (!idle(i)) changes.mark(i);
+
+				// update animation time
+				if (left[i] > 0.0f) {
+					if (left[i] < delta) left[i] = 0.0f;
+					else left[i] -= delta;
+					if (disable[i]) {
+						active[i] = false;
+						disable[i] = false;
+					};
+					bumps[i] = false;
 				};
-				bumps = false;
-			};
 
-			// restart animation
-			if (left == 0.0f && active) {
-				bumps = true;
-				left = convTicks(root->time);
+				// restart animation
+				if (left[i] == 0.0f && active[i]) {
+					bumps[i] = true;
+					left[i] = convTicks(root[i]->time);
+				};
 			};
+			refresh();
+		};
 
-			// update bumper model
-			float t = glm::clamp((convTicks(root->time) - left) / convTicks(root->bump), 0.0f, 1.0f);
-			Models::Bumper::animate(*object, root->dir, t);
+		/// Updates bumper models from current animation times.
+		void refresh() {
+			if (objects.empty()) return;
+			for (size_t i = 0; i < size(); i++)
+				Models::Bumper::animate(objects[i], root[i]->dir, progress(i));
 		};
 
-		/// Draws the moving platform.
+		/// Draws the bumpers.
 		/// @return Drawn vertex count.
 		size_t draw() const {
-			Assets::terrain.bind();
-			size_t vert = object->draw(Shaders::tex);
-			float t = glm::clamp((convTicks(root->time) - left) / convTicks(root->bump), 0.0f, 1.0f);
-			if (t < 0.4f) {
-				Assets::mask.bind();
-				vert += Models::drawHint((root->pos + vec3x(0, 0, 1)).gl());
+			size_t vert = 0;
+			if (objects.empty()) return 0;
+			for (size_t i = 0; i < size(); i++) {
+				vert += RenderQueue::submit(RenderQueue::Color, RenderQueue::Solid, Shaders::tex, Assets::terrain, objects[i]);
+				if (progress(i) < 0.4f)
+					vert += Models::drawHint((root[i]->pos + vec3x(0, 0, 1)).gl());
 			};
 			return vert;
 		};
 
 		/// Checks if the cube is in range of bumper impulse volume.
-		bool in(const vol3x& cube) {
+		/// @param idx Bumper index.
+		/// @param cube Cube collision volume.
+		bool in(size_t idx, const vol3x& cube) const {
 			// checks if bumper is active
-			if (!bumps) return false;
+			if (!bumps[idx]) return false;
 
 			// generate impulse volume
+			const Bytes::Bumper& data = *root[idx];
 			vol3x volume;
 			fix w = 0.125fx;
-			switch (root->dir) {
-				case East : volume = vol3x(root->pos - vec3x(w, 0, 0), vec3x(w, 1, 1)); break;
-				case West : volume = vol3x(root->pos + vec3x(1, 0, 0), vec3x(w, 1, 1)); break;
-				case North: volume = vol3x(root->pos - vec3x(0, w, 0), vec3x(1, w, 1)); break;
-				case South: volume = vol3x(root->pos + vec3x(0, 1, 0), vec3x(1, w, 1)); break;
+			switch (data.dir) {
+				case East : volume = vol3x(data.pos - vec3x(w, 0, 0), vec3x(w, 1, 1)); break;
+				case West : volume = vol3x(data.pos + vec3x(1, 0, 0), vec3x(w, 1, 1)); break;
+				case North: volume = vol3x(data.pos - vec3x(0, w, 0), vec3x(1, w, 1)); break;
+				case South: volume = vol3x(data.pos + vec3x(0, 1, 0), vec3x(1, w, 1)); break;
 			};
 
 			// compare volumes
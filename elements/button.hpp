@@ -2,69 +2,137 @@
 
 /// Level related namespace.
 namespace Level {
-	/// Button object.
-	struct Button {
+	/// Button list.
+	/// @note Simulation fields are stored in separate arrays, so per-tick kernels stream only over hot data.
+	/// @note Boolean fields are stored as bytes, since `std::vector<bool>` elements cannot be referenced.
+	struct Buttons {
 		/// Button data.
-		const Bytes::Button* root;
+		std::vector<const Bytes::Button*> root;
 
-		/// Button state.
-		bool state;
-		/// Whether the button is under the cube.
-		bool pressed;
+		std::vector<uint8_t>   state; // Button states.
+		std::vector<uint8_t> pressed; // Whether buttons are under the cube.
+		std::vector<size_t>     held; // Indices of pressed buttons, in no particular order.
 
-		/// Structure constructor.
+		/// Returns button count.
+		size_t size() const { return root.size(); };
+
+		/// Adds a button.
 		/// @param data Button data.
-		Button (const Bytes::Button* data): root(data), state(data->state), pressed(false) {};
+		void add(const Bytes::Button* data) {
+			root.push_back(data);
+			state.push_back(data->state);
+			pressed.push_back(false);
+		};
+
+		/// Copies button state from another list.
+		/// @param idx Button index.
+		/// @param src Source button list.
+		void copy(size_t idx, const Buttons& src) {
+			state[idx] = src.state[idx];
+			if (src.pressed[idx]) press(idx);
+			else for (size_t k = 0; k < held.size(); k++)
+				if (held[k] == idx) { release(k); break; };
+		};
+
+		/// Marks a button as pressed.
+		/// @param idx Button index.
+		/// @return Whether the button was released before.
+		bool press(size_t idx) {
+			if (pressed[idx]) return false;
+			pressed[idx] = true;
+			held.push_back(idx);
+			return true;
+		};
+
+		/// Releases a pressed button.
+		/// @param k Position in the pressed index list.
+		/// @note The last pressed index takes its place.
+		void release(size_t k) {
+			pressed[held[k]] = false;
+			held[k] = held.back();
+			held.pop_back();
+		};
 
-		/// Draws the button.
-		/// @param plats Moving platform object list.
+		/// Draws the buttons.
+		/// @param plats Moving platform list.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t draw(const std::vector<Moving>& plats) const {
-			if (!root->visible) return 0;
-			Assets::plat.bind();
-			return Models::drawButton(volume(plats).pos.gl(), state);
+		size_t draw(const MovingPlats& plats, float alpha) const {
+			size_t vertcount = 0;
+			for (size_t i = 0; i < size(); i++) {
+				const Bytes::Button& data = *root[i];
+				if (!data.visible) continue;
+				if (data.attached)
+					vertcount += Models::drawButton(plats.render(data.moving, alpha) + glm::vec3(0.0f, 1.0f, 0.0f), state[i]);
+				else
+					vertcount += Models::drawButton(data.pos.gl(), state[i]);
+			};
+			return vertcount;
 		};
 
-		/// Updates the button state.
-		void update() {
-			if (!pressed && root->stayup)
-				state = false;
+		/// Visits button simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) {
+			for (size_t i = 0; i < size(); i++)
+				snap(state[i])(pressed[i]);
+
+			// rebuild pressed index list
+			if (snap.loading()) {
+				held.clear();
+				for (size_t i = 0; i < size(); i++)
+					if (pressed[i]) held.push_back(i);
+			};
 		};
 
-		/// Returns button volume.
-		/// @param plats Moving platform object list.
-		vol3x volume(const std::vector<Moving>& plats) const {
-			return vol3x(
-				root->attached
-					? plats[root->moving].now + vec3x(0, 0, 1)
-					: root->pos,
-			vec3x(1, 1, 0.25fx));
+		/// Updates button states.
+		/// @param changes Changed button set.
+		void update(Dirty& changes) {
+			const size_t count = size();
+			for (size_t i = 0; i < count; i++) {
+				if (pressed[i] || !state[i] || !root[i]->stayup) continue;
+				state[i] = false;
+				changes.mark(i);
+			};
 		};
 
+		/// Returns button position.
+		/// @param idx Button index.
+		/// @param plats Moving platform list.
+		vec3x pos(size_t idx, const MovingPlats& plats) const {
+			return root[idx]->attached
+				? plats.now[root[idx]->moving] + vec3x(0, 0, 1)
+				: root[idx]->pos;
+		};
+
+		/// Returns button volume.
+		/// @param idx Button index.
+		/// @param plats Moving platform list.
+		vol3x volume(size_t idx, const MovingPlats& plats) const { return vol3x(pos(idx, plats), vec3x(1, 1, 0.25fx)); };
+
 		/// Executes button commands.
+		/// @param idx Button index.
 		/// @param movingPlats Moving platform list.
-		/// @param buttons Button list.
 		/// @param bumpers Bumper list.
-		void execute(std::vector<Moving>& movingPlats, std::vector<Button>& buttons, std::vector<Bumper>& bumpers) {
-			for (const Bytes::MovingCommand cmd : root->movings)
-				movingPlats[cmd.id].move(cmd.way);
-			for (const Bytes::ButtonCommand cmd : root->buttons)
-				buttons[cmd.id].state = cmd.state;
-			for (const Bytes::BumperCommand cmd : root->bumpers)
-				bumpers[cmd.id].trigger(cmd.act);
+		void execute(size_t idx, MovingPlats& movingPlats, Bumpers& bumpers) {
+			for (const Bytes::MovingCommand cmd : root[idx]->movings)
+				movingPlats.move(cmd.id, cmd.way);
+			for (const Bytes::ButtonCommand cmd : root[idx]->buttons)
+				state[cmd.id] = cmd.state;
+			for (const Bytes::BumperCommand cmd : root[idx]->bumpers)
+				bumpers.trigger(cmd.id, cmd.act);
 		};
 
 		/// Executes and immediately procs button commands.
+		/// @param idx Button index.
 		/// @param movingPlats Moving platform list.
-		/// @param buttons Button list.
 		/// @param bumpers Bumper list.
-		void proc(std::vector<Moving>& movingPlats, std::vector<Button>& buttons, std::vector<Bumper>& bumpers) {
-			for (const Bytes::MovingCommand cmd : root->movings)
-				movingPlats[cmd.id].proc(cmd.way);
-			for (const Bytes::ButtonCommand cmd : root->buttons)
-				buttons[cmd.id].state = cmd.state;
-			for (const Bytes::BumperCommand cmd : root->bumpers)
-				bumpers[cmd.id].trigger(cmd.act);
+		void proc(size_t idx, MovingPlats& movingPlats, Bumpers& bumpers) {
+			for (const Bytes::MovingCommand cmd : root[idx]->movings)
+				movingPlats.proc(cmd.id, cmd.way);
+			for (const Bytes::ButtonCommand cmd : root[idx]->buttons)
+				state[cmd.id] = cmd.state;
+			for (const Bytes::BumperCommand cmd : root[idx]->bumpers)
+				bumpers.trigger(cmd.id, cmd.act);
 		};
 	};
 };
\ No newline at end of file
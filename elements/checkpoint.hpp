@@ -13,5 +13,9 @@ namespace Level {
 		/// Structure constructor.
 		/// @param data Checkpoint data.
 		Checkpoint (const Bytes::Checkpoint* data): root(data), active(true) {};
+
+		/// Visits checkpoint simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) { snap(active); };
 	};
 };
\ No newline at end of file
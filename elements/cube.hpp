@@ -60,6 +60,8 @@ namespace Level {
 		vec3x minipos() const { return (offset + tile) * 3fx + vec3x(mini.x, mini.y, mini.z); };
 		/// Cube true position.
 		vec3x pos() const { return minipos() / 3fx - animoff; };
+		/// Cube position before last simulation step.
+		vec3x prev;
 		/// Cube collision volume.
 		vol3x volume;
 
@@ -99,6 +101,21 @@ namespace Level {
 			.shadow = Models::Cube::shadowZ,
 			.mini = false
 		};
+		/// Cube shape the models were last built for.
+		struct Shape {
+			Action act;                      /// Animation type.
+			Direction dir;                   /// Animation direction.
+			fix t;                           /// Animation progress.
+			Models::Cube::Settings settings; /// Render settings.
+
+			/// Checks if shapes match.
+			bool operator==(const Shape& shape) const {
+				return act == shape.act && dir == shape.dir && t == shape.t && settings.size == shape.settings.size
+					&& settings.shadow == shape.settings.shadow && settings.mini == shape.settings.mini;
+			};
+		} shape;
+		/// Whether the models hold a built shape.
+		bool shaped = false;
 
 		/// Cube destructor.
 		~Cube () { delete mod_cube; delete mod_shadow; mod_cube = NULL; mod_shadow = NULL; };
@@ -136,6 +153,7 @@ namespace Level {
 				settings.mini = false;
 				animoff = vec3x(0);
 			};
+			prev = pos();
 
 			// generate cube models
 			model();
@@ -150,6 +168,7 @@ namespace Level {
 			tile(cube.tile),
 			mini(cube.mini),
 			animoff(cube.animoff),
+			prev(cube.prev),
 			rel(cube.rel),
 			clamp(cube.clamp),
 			clampspeed(cube.clampspeed),
@@ -179,6 +198,7 @@ namespace Level {
 			tile = cube.tile;
 			mini = cube.mini;
 			animoff = cube.animoff;
+			prev = cube.prev;
 			rel = cube.rel;
 			clamp = cube.clamp;
 			clampspeed = cube.clampspeed;
@@ -201,129 +221,139 @@ namespace Level {
 			return *this;
 		};
 
+		/// Visits cube simulation state.
+		/// @param snap State serializer.
+		/// @param paths Paths the cube keymap may follow.
+		/// @note Models are kept, as they are rebuilt from the state on next update.
+		void frame(Snapshot& snap, const std::vector<const Bytes::Path*>& paths) {
+			keys.frame(snap, paths);
+			snap(offset)(tile)(mini)(animoff)(rel)(clamp)(clampspeed)(clampdir)(prev)(volume);
+			snap(act)(dir)(t)(dt)(speed)(energy)(bump)(fallimmune)(alignimmune);
+			snap(climb)(hang)(dark)(player)(settings.size)(settings.shadow)(settings.mini);
+		};
+
 		/// Generates a cube model if needed.
+		/// @note Headless builds never generate models.
 		void model() {
+			#ifndef HEADLESS
 			if (mod_cube == NULL) {
 				mod_cube   = new Object;
 				mod_shadow = new Object;
 				Models::Cube::generate(*mod_cube, *mod_shadow);
+				shaped = false;
 			};
+			#endif
 		};
 
 		/// Updates cube state.
 		/// @param delta Elapsed time since last frame.
 		/// @param model Whether to update the models.
+		/// @note If `model` is false, only the collision volume is recalculated.
 		void update(float delta, bool model) {
-			this->model();
+			if (model) this->model();
 
-			// update model position
-			mod_cube->pos = pos().gl();
-			mod_shadow->pos = mod_cube->pos;
+			// rebuild models only if their shape changes
+			Shape now = { act, dir, t, settings };
+			bool reshape = model && mod_cube != NULL && !inactive() && !(shaped && shape == now);
+
+			// select render proxies
+			Object* cube   = reshape ? mod_cube   : NULL;
+			Object* shadow = reshape ? mod_shadow : NULL;
 
-			// animate model
+			// animate collision volume
 			switch (act) {
 				case Crush: case Exit:
 					volume = vol3x();
 					break;
 				case Roll: case RollQF: case RollQB:
-					volume = Models::Cube::roll(*mod_cube, *mod_shadow, dir, t, settings);
+					volume = Models::Cube::roll(cube, shadow, dir, t, settings);
 					break;
 				case Hang: case HangQF: case HangQB:
-					volume = Models::Cube::hang(*mod_cube, *mod_shadow, dir, t, settings);
+					volume = Models::Cube::hang(cube, shadow, dir, t, settings);
 					break;
 				case Shrink:
-					volume = Models::Cube::resize(*mod_cube, *mod_shadow, t, settings.shadow, settings.size);
+					volume = Models::Cube::resize(cube, shadow, t, settings.shadow, settings.size);
 					break;
 				case Grow:
-					volume = Models::Cube::resize(*mod_cube, *mod_shadow, 1fx - t, settings.shadow, settings.size);
+					volume = Models::Cube::resize(cube, shadow, 1fx - t, settings.shadow, settings.size);
 					break;
 				default:
-					volume = Models::Cube::roll(*mod_cube, *mod_shadow, dir, t, settings);
+					volume = Models::Cube::roll(cube, shadow, dir, t, settings);
 					break;
 			};
 			volume += pos();
 
-			// update model colors
-			if (dark) {
-				switch (act) {
-					case Crush: case Exit:
-						break;
-					case Roll: case RollQF: case RollQB: case Hang: case HangQF: case HangQB: {
-						switch (dir) {
-							case East: case West:
-								Models::Prism::colorX(*mod_cube, Rainbow::darkGradXY(t));
-								Models::Prism::colorY(*mod_cube, Rainbow::darkGradYX(t));
-								Models::Prism::colorZ(*mod_cube, Rainbow::darkPrismZ());
-								break;
-							case North: case South:
-								Models::Prism::colorX(*mod_cube, Rainbow::darkPrismX());
-								Models::Prism::colorY(*mod_cube, Rainbow::darkGradYZ(t));
-								Models::Prism::colorZ(*mod_cube, Rainbow::darkGradZY(t));
-								break;
-						};
-					}; break;
-					default:
-						Models::Prism::colorX(*mod_cube, Rainbow::darkPrismX());
-						Models::Prism::colorY(*mod_cube, Rainbow::darkPrismY());
-						Models::Prism::colorZ(*mod_cube, Rainbow::darkPrismZ());
-						break;
-				};
-			} else {
-				switch (act) {
-					case Crush: case Exit:
-						break;
-					case Roll: case RollQF: case RollQB: case Hang: case HangQF: case HangQB: {
-						switch (dir) {
-							case East: case West:
-								Models::Prism::colorX(*mod_cube, Rainbow::gradXY(player, t));
-								Models::Prism::colorY(*mod_cube, Rainbow::gradYX(player, t));
-								Models::Prism::colorZ(*mod_cube, Rainbow::cubeZ(player));
-								break;
-							case North: case South:
-								Models::Prism::colorX(*mod_cube, Rainbow::cubeX(player));
-								Models::Prism::colorY(*mod_cube, Rainbow::gradYZ(player, t));
-								Models::Prism::colorZ(*mod_cube, Rainbow::gradZY(player, t));
-								break;
-						};
-					}; break;
-					default:
-						Models::Prism::colorX(*mod_cube, Rainbow::cubeX(player));
-						Models::Prism::colorY(*mod_cube, Rainbow::cubeY(player));
-						Models::Prism::colorZ(*mod_cube, Rainbow::cubeZ(player));
-						break;
-				};
+			// ignore models if not present
+			if (!model || mod_cube == NULL) return;
+
+			// upload rebuilt models
+			if (reshape) {
+				mod_cube->update();
+				mod_shadow->update();
+				shape = now;
+				shaped = true;
 			};
 
-			// update models
-			mod_cube->update();
-			mod_shadow->update();
+			// update model position
+			mod_cube->pos = pos().gl();
+			mod_shadow->pos = mod_cube->pos;
+
+			// crushed & exited cubes keep their last colors
+			if (inactive()) return;
+
+			// update model colors
+			Object::Hue& hue = mod_cube->hue;
+			hue.rows = dark ? Rainbow::darkRows : Rainbow::cubeRows;
+			hue.timer = dark ? Timers::fast.value() : (player ? Timers::cube : Timers::darkcube).value();
+			hue.to = glm::ivec3(0, 1, 2);
+			hue.mix = 0.0f;
+
+			// rolling faces blend towards colors of faces they turn into
+			switch (act) {
+				case Roll: case RollQF: case RollQB: case Hang: case HangQF: case HangQB:
+					hue.to = (dir == East || dir == West) ? glm::ivec3(1, 0, 2) : glm::ivec3(0, 2, 1);
+					hue.mix = (float)t;
+					break;
+				default:
+					break;
+			};
 		};
 
+		/// Returns interpolated cube render position.
+		/// @param alpha Progress from previous to current position.
+		glm::vec3 render(float alpha) const { return lerpv(prev.gl(), pos().gl(), alpha); };
+
+		/// Drops render blending for the current step.
+		/// @note Used when the cube position changes discretely, as roll and hang motion is not blended.
+		void settle() { prev = pos(); };
+
 		/// Draws the cube.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t draw() {
+		size_t draw(float alpha) {
 			model();
 			if (act == Crush || act == Exit) return 0;
-			Assets::mask.bind();
-			mod_cube->pos = pos().gl();
-			return mod_cube->draw(Shaders::tex);
+			mod_cube->pos = render(alpha);
+			return RenderQueue::submit(RenderQueue::Color, RenderQueue::Solid, Shaders::tex, Assets::mask, *mod_cube);
 		};
 
 		/// Draws cube's shadow.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t shadow() {
+		size_t shadow(float alpha) {
 			model();
 			if (act == Crush || act == Exit) return 0;
-			Assets::mask.bind();
-			mod_shadow->pos = pos().gl();
-			return mod_shadow->draw(Shaders::tex);
+			mod_shadow->pos = render(alpha);
+			return RenderQueue::submit(RenderQueue::Shadow, RenderQueue::Solid, Shaders::tex, Assets::mask, *mod_shadow);
 		};
 
 		/// Get current cube input.
 		/// @param player Whether the cube is a player.
 		CubeInput getInput(bool player) {
+			#ifndef HEADLESS
 			if (player)
 				keys.set(CubeInput::keyboard());
+			#endif
 			return keys.state();
 		};
 
@@ -374,10 +404,10 @@ namespace Level {
 		/// Attaches cube to a moving platform.
 		/// @param plats Moving platform list.
 		/// @param idx Moving platform index.
-		void attach(const std::vector<Moving>& plats, size_t idx) {
+		void attach(const MovingPlats& plats, size_t idx) {
 			// fetch platform positions
-			vec3x src = rel != -1ULL ? plats[rel].now : vec3x(0);
-			vec3x dst = idx != -1ULL ? plats[idx].now : vec3x(0);
+			vec3x src = rel != -1ULL ? plats.now[rel] : vec3x(0);
+			vec3x dst = idx != -1ULL ? plats.now[idx] : vec3x(0);
 
 			// translate cube basis
 			offset += dst - src;
@@ -388,12 +418,12 @@ namespace Level {
 		/// Syncs cube relative offset.
 		/// @param plats Moving platform list.
 		/// @param tick Moving platform tick timer pointer.
-		void syncOffset(const std::vector<Moving>& plats, float* tick) {
-			offset = rel != -1ULL ? plats[rel].now : vec3x(0);
+		void syncOffset(const MovingPlats& plats, float* tick) {
+			offset = rel != -1ULL ? plats.now[rel] : vec3x(0);
 			if (rel == -1ULL || tick == NULL) return;
 
 			// update tick timer
-			float vel = (float)(plats[rel].velocity().sqr() * 27fx);
+			float vel = (float)(plats.velocity(rel).sqr() * 27fx);
 			*tick = (vel == 0.0f) ? 0.9f : *tick + vel;
 			if (floorf(*tick)) {
 				*tick = fmod(*tick, 1.0f);
@@ -13,5 +13,9 @@ namespace Level {
 		/// Structure constructor.
 		/// @param data Spawner data.
 		DarkCube (const Bytes::DarkCube* data): root(data), active(true) {};
+
+		/// Visits spawner simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) { snap(active); };
 	};
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Changed element index set.
+	class Dirty {
+		private:
+		/// Changed element indices.
+		std::vector<size_t> list;
+		/// Whether an element is in the list.
+		std::vector<bool> marks;
+
+		public:
+		/// Resets the set for a new element count.
+		/// @param count Element count.
+		void reset(size_t count) {
+			list.clear();
+			marks.assign(count, false);
+		};
+
+		/// Marks an element as changed.
+		/// @param idx Element index.
+		void mark(size_t idx) {
+			if (marks[idx]) return;
+			marks[idx] = true;
+			list.push_back(idx);
+		};
+
+		/// Marks all elements as changed.
+		void fill() {
+			for (size_t idx = 0; idx < marks.size(); idx++) mark(idx);
+		};
+
+		/// Adds all elements of another set.
+		/// @param oth Merged set.
+		void merge(const Dirty& oth) {
+			for (size_t idx : oth.list) mark(idx);
+		};
+
+		/// Clears the set.
+		void clear() {
+			for (size_t idx : list) marks[idx] = false;
+			list.clear();
+		};
+
+		/// Copies changed elements between lists.
+		/// @param dst Destination list.
+		/// @param src Source list.
+		template <typename T> void copy(std::vector<T>& dst, const std::vector<T>& src) const {
+			for (size_t idx : list) dst[idx] = src[idx];
+		};
+
+		/// Copies changed elements between element lists.
+		/// @param dst Destination list.
+		/// @param src Source list.
+		template <typename T> void copy(T& dst, const T& src) const {
+			for (size_t idx : list) dst.copy(idx, src);
+		};
+	};
+};
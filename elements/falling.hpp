@@ -5,8 +5,9 @@ namespace Level {
 	// import model theme
 	using Models::Theme;
 
-	/// Falling platform object.
-	struct Falling {
+	/// Falling platform list.
+	/// @note Simulation fields are stored in separate arrays, so per-tick kernels stream only over hot data.
+	struct FallingPlats {
 		/// Falling platform state type.
 		enum State {
 			Solid, // Platform floats.
@@ -15,69 +16,118 @@ namespace Level {
 		};
 
 		/// Falling platform data.
-		const Bytes::Falling* root;
+		std::vector<const Bytes::Falling*> root;
 
-		vec3x   pos; // Platform position.
-		fix  speedz; // Platform vertical speed.
-		float  left; // Unstable time left.
-		State state; // Whether the platform is falling.
+		std::vector<vec3x>    pos; // Platform positions.
+		std::vector<vec3x>   prev; // Previous platform positions.
+		std::vector<fix>   speedz; // Platform vertical speeds.
+		std::vector<float>   left; // Unstable time left.
+		std::vector<State>  state; // Platform states.
 
-		/// Structure constructor.
+		/// Returns platform count.
+		size_t size() const { return root.size(); };
+
+		/// Adds a falling platform.
 		/// @param data Falling platform data.
-		Falling (const Bytes::Falling* data): root(data) {
-			pos = root->pos;
-			state = Solid;
+		void add(const Bytes::Falling* data) {
+			root.push_back(data);
+			pos.push_back(data->pos);
+			prev.push_back(data->pos);
+			speedz.push_back(0fx);
+			left.push_back(0.0f);
+			state.push_back(Solid);
+		};
+
+		/// Copies platform state from another list.
+		/// @param idx Platform index.
+		/// @param src Source platform list.
+		void copy(size_t idx, const FallingPlats& src) {
+			pos[idx] = src.pos[idx];
+			prev[idx] = src.prev[idx];
+			speedz[idx] = src.speedz[idx];
+			left[idx] = src.left[idx];
+			state[idx] = src.state[idx];
 		};
 
-		/// Checks if falling platform counts as ground.
-		bool active() const { return state != Fall; };
+		/// Checks if a falling platform counts as ground.
+		/// @param idx Platform index.
+		bool active(size_t idx) const { return state[idx] != Fall; };
+
+		/// Checks if a falling platform should be despawned.
+		/// @param idx Platform index.
+		bool despawn(size_t idx) const { return pos[idx].z <= -16fx; };
 
-		/// Checks if falling platform should be despawned.
-		bool despawn() const { return pos.z <= -16fx; };
+		/// Visits platform simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) {
+			for (size_t i = 0; i < size(); i++)
+				snap(pos[i])(prev[i])(speedz[i])(left[i])(state[i]);
+		};
+
+		/// Checks whether updates leave a platform unchanged.
+		/// @param idx Platform index.
+		bool idle(size_t idx) const { return prev[idx] == pos[idx] && (state[idx] == Solid || (state[idx] == Fall && despawn(idx))); };
 
 		/// Triggers falling platform fall animation.
-		void trigger() { if (state != Solid) return; left = convTicks(root->time); state = Decay; Assets::sfx(Assets::Decay); };
+		/// @param idx Platform index.
+		void trigger(size_t idx) {
+			if (state[idx] != Solid) return;
+			left[idx] = convTicks(root[idx]->time);
+			state[idx] = Decay;
+			Assets::sfx(Assets::Decay);
+		};
 
-		/// Updates falling platform state.
+		/// Updates falling platform states.
 		/// @param delta Elapsed time since last frame.
-		void update(float delta) {
-			switch (state) {
-				// update platform decay time
-				case Decay: {
-					if (left < delta) {
-						speedz = 0fx;
-						state = Fall;
-						Assets::sfx(Assets::Drop);
-						break;
-					};
-					left -= delta;
-				}; break;
-				// accelerate platform downwards
-				case Fall: {
-					if (pos.z <= -16fx) break;
-					speedz = (speedz + 0.125fx).clamp(0fx, 0.22fx);
-					pos.z -= speedz;
-				}; break;
-				// no action otherwise
-				default: break;
+		/// @param changes Changed platform set.
+		void update(float delta, Dirty& changes) {
+			const size_t count = size();
+			for (size_t i = 0; i < count; i++) {
+				if (!idle(i)) changes.mark(i);
+				prev[i] = pos[i];
+
+				// advance unstable platforms
+				switch (state[i]) {
+					// update platform decay time
+					case Decay: {
+						if (left[i] < delta) {
+							speedz[i] = 0fx;
+							state[i] = Fall;
+							Assets::sfx(Assets::Drop);
+							break;
+						};
+						left[i] -= delta;
+					}; break;
+					// accelerate platform downwards
+					case Fall: {
+						if (pos[i].z <= -16fx) break;
+						speedz[i] = (speedz[i] + 0.125fx).clamp(0fx, 0.22fx);
+						pos[i].z -= speedz[i];
+					}; break;
+					// no action otherwise
+					default: break;
+				};
 			};
 		};
 
-		/// Draws the falling platform.
+		/// Draws the falling platforms.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t draw() {
-			if (!despawn()) {
-				Assets::plat.bind();
-				return Models::drawFalling(pos.gl(), root->theme);
+		size_t draw(float alpha) const {
+			size_t vertcount = 0;
+			for (size_t i = 0; i < size(); i++) {
+				if (despawn(i)) continue;
+				vertcount += Models::drawFalling(lerpv(prev[i].gl(), pos[i].gl(), alpha), root[i]->theme);
 			};
-			return 0;
+			return vertcount;
 		};
 
 		/// Generates falling platform volume.
-		vol3x volume() const {
-			if (state != Solid)
+		/// @param idx Platform index.
+		vol3x volume(size_t idx) const {
+			if (state[idx] != Solid)
 				return vol3x(vec3x(0), vec3x(0));
-			return vol3x(vec3x(0, 0, 1.0f - Models::Falling::height), vec3x(1, 1, Models::Falling::height)) + pos;
+			return vol3x(vec3x(0, 0, 1.0f - Models::Falling::height), vec3x(1, 1, Models::Falling::height)) + pos[idx];
 		};
 	};
 };
\ No newline at end of file
@@ -110,20 +110,32 @@ namespace Level {
 			return false;
 		};
 
+		/// Visits key map simulation state.
+		/// @param snap State serializer.
+		/// @param paths Paths a key map may follow.
+		/// @note Path is stored as an index into `paths`, so frames stay valid for other level instances.
+		void frame(Snapshot& snap, const std::vector<const Bytes::Path*>& paths) {
+			size_t found = std::find(paths.begin(), paths.end(), root) - paths.begin();
+			uint16_t path = (root == NULL || found == paths.size()) ? 0xffff : found;
+			snap(path)(left)(idx)(sync)(moving)(waypoint);
+			if (snap.loading()) root = path < paths.size() ? paths[path] : NULL;
+			snap(input.east)(input.west)(input.north)(input.south);
+		};
+
 		/// Checks if a keymap is active.
 		bool active() const { return !(root == NULL || idx == -1ULL); };
 
 		/// Updates key map.
 		/// @param delta Time elapsed since last frame.
 		/// @param plats Moving platform list.
-		void update(const std::vector<Moving>& plats, float delta) {
+		void update(const MovingPlats& plats, float delta) {
 			// check if key map needs updates
 			if (!active()) return;
 
 			// check for syncing
 			if (sync) {
 				// check if moving platform is inactive
-				if (plats[moving].waypoint == waypoint && plats[moving].paused()) {
+				if (plats.waypoint[moving] == waypoint && plats.paused(moving)) {
 					sync = false;
 				} else return;
 			};
@@ -8,6 +8,15 @@ namespace Level {
 		return ticks / 240.0f;
 	};
 
+	/// Convert time into ticks.
+	/// @param time Elapsed time.
+	uint32_t convTime(float time) {
+		return (uint32_t)(time * 240.0f + 0.5f);
+	};
+
+	/// Level ticks per simulation step.
+	const uint32_t stepTicks = convTime(Timers::step);
+
 	/// Smoothly clamps a value to [-bound, bound].
 	/// @param val Initial value.
 	/// @param bound Value range bounds.
@@ -115,8 +124,14 @@ namespace Level {
 };
 
 // include level element units
+#include "occupancy.hpp"
 #include "terrain.hpp"
+#include "snapshot.hpp"
+#include "rewind.hpp"
+#include "dirty.hpp"
+#include "models.hpp"
 #include "moving.hpp"
+#include "broadphase.hpp"
 #include "falling.hpp"
 #include "bumper.hpp"
 #include "resizer.hpp"
@@ -127,6 +142,7 @@ namespace Level {
 #include "button.hpp"
 #include "camera.hpp"
 #include "darkcube.hpp"
+#include "triggers.hpp"
 #include "recorder.hpp"
 
 /// Level related namespace.
@@ -145,13 +161,13 @@ namespace Level {
 
 	/// Level state object.
 	struct State {
-		std::vector<Moving>     movingPlats; // Moving platform list.
-		std::vector<Falling>   fallingPlats; // Falling platform list.
-		std::vector<Bumper>         bumpers; // Bumper list.
+		MovingPlats             movingPlats; // Moving platform list.
+		FallingPlats           fallingPlats; // Falling platform list.
+		Bumpers                     bumpers; // Bumper list.
 		std::vector<Resizer>       resizers; // Resizer list.
 		std::vector<Prism>           prisms; // Prism list.
 		std::vector<Checkpoint>      checks; // Checkpoint list.
-		std::vector<Button>         buttons; // Button list.
+		Buttons                     buttons; // Button list.
 		std::vector<CameraTrigger> triggers; // Camera trigger list.
 		std::vector<DarkCube>     darkcubes; // Dark cube spawner list.
 		std::deque <Cube>             cubes; // Cube list.
@@ -171,6 +187,89 @@ namespace Level {
 		System particles;
 	};
 
+	/// Level state change journal.
+	/// @note Triggers and resizers are never modified, so they are not tracked.
+	/// @note Cubes are copied as a whole, as there are only a few of them.
+	struct Journal {
+		Dirty  movingPlats; // Changed moving platforms.
+		Dirty fallingPlats; // Changed falling platforms.
+		Dirty      bumpers; // Changed bumpers.
+		Dirty       checks; // Changed checkpoints.
+		Dirty      buttons; // Changed buttons.
+		Dirty    darkcubes; // Changed dark cube spawners.
+
+		/// Whether the prism list has changed.
+		bool prisms = false;
+
+		/// Resets the journal for a level state.
+		/// @param state Tracked level state.
+		void reset(const State& state) {
+			movingPlats.reset(state.movingPlats.size());
+			fallingPlats.reset(state.fallingPlats.size());
+			bumpers.reset(state.bumpers.size());
+			checks.reset(state.checks.size());
+			buttons.reset(state.buttons.size());
+			darkcubes.reset(state.darkcubes.size());
+			prisms = false;
+		};
+
+		/// Marks all elements as changed.
+		void fill() {
+			movingPlats.fill();
+			fallingPlats.fill();
+			bumpers.fill();
+			checks.fill();
+			buttons.fill();
+			darkcubes.fill();
+			prisms = true;
+		};
+
+		/// Adds all changes of another journal.
+		/// @param oth Merged journal.
+		void merge(const Journal& oth) {
+			movingPlats.merge(oth.movingPlats);
+			fallingPlats.merge(oth.fallingPlats);
+			bumpers.merge(oth.bumpers);
+			checks.merge(oth.checks);
+			buttons.merge(oth.buttons);
+			darkcubes.merge(oth.darkcubes);
+			prisms |= oth.prisms;
+		};
+
+		/// Clears all changes.
+		void clear() {
+			movingPlats.clear();
+			fallingPlats.clear();
+			bumpers.clear();
+			checks.clear();
+			buttons.clear();
+			darkcubes.clear();
+			prisms = false;
+		};
+
+		/// Copies changed state between level states.
+		/// @param dst Destination state.
+		/// @param src Source state.
+		/// @note Particles are not copied.
+		void copy(State& dst, const State& src) const {
+			movingPlats.copy(dst.movingPlats, src.movingPlats);
+			fallingPlats.copy(dst.fallingPlats, src.fallingPlats);
+			bumpers.copy(dst.bumpers, src.bumpers);
+			checks.copy(dst.checks, src.checks);
+			buttons.copy(dst.buttons, src.buttons);
+			darkcubes.copy(dst.darkcubes, src.darkcubes);
+			if (prisms) dst.prisms = src.prisms;
+
+			// copy cubes & state values
+			dst.cubes = src.cubes;
+			dst.player = src.player;
+			dst.last = src.last;
+			dst.lock = src.lock;
+			dst.prism = src.prism;
+			dst.grad = src.grad;
+		};
+	};
+
 	/// Level object.
 	struct Level {
 		/// Level data
@@ -180,10 +279,34 @@ namespace Level {
 
 		/// Current level state.
 		State state;
+		/// Moving platform spatial index.
+		Broadphase movingGrid;
+		/// Cube interaction trigger spatial index.
+		Triggers triggerGrid;
 		/// Last checkpoint level state.
 		State last;
 		/// Initial checkpoint.
 		State init;
+		/// Changes since last checkpoint.
+		Journal changes;
+		/// Changes of last checkpoint since initial checkpoint.
+		Journal history;
+		/// Rewind buffer of past ticks.
+		Rewind timeline;
+		/// Snapshot data buffer.
+		std::vector<uint8_t> snapshot;
+		/// Simulated step count.
+		size_t steps = 0;
+		/// State hash trace stream.
+		FILE* trace = NULL;
+		#ifdef HEADLESS
+		/// Captured rewind frame count.
+		size_t captures = 0;
+		/// Time spent capturing rewind frames.
+		sf::Time captureTime;
+		#endif
+		/// Paths cube keymaps may follow (dark cube paths, then player input path).
+		std::vector<const Bytes::Path*> paths;
 		/// Last checkpoint camera state.
 		CameraTarget camerastate;
 		/// Initial camera state.
@@ -217,6 +340,8 @@ namespace Level {
 
 		/// Camera follow position.
 		glm::vec3 followPos;
+		/// Camera position before last follow step.
+		glm::vec3 followPrev;
 		/// Whether to lock follow position.
 		bool followLock;
 		/// Exit animation request.
@@ -228,12 +353,15 @@ namespace Level {
 		bool world;
 		/// Mute sound of next prism.
 		bool mutePrism;
+		/// Particle random generator state.
+		/// @note Each level owns its generator, so levels can be simulated on parallel threads.
+		uint32_t seed = 0x2545F491;
 
 		/// Structure constructor.
 		/// @param data Level data.
 		/// @param world Whether the level is a worldmap.
 		Level (Bytes::Level data = {}, bool world = false):
-			root(data), deaths(0), tick(0), firstcontact(false), POI(0),
+			root(data), deaths(0), anim(0), tick(0), firstcontact(false), POI(0),
 			followLock(false), exitReq(false), world(world), mutePrism(false)
 		{
 			// default camera settings
@@ -241,6 +369,7 @@ namespace Level {
 			camera.off = glm::vec3(8.0f);
 			camera.targetOff(CameraTrigger::zooms(data.zoom), 0.5f);
 			initcamera = camera.store();
+			followPrev = camera.pos;
 
 			// generate terrain object
 			terrain = Terrain(root.terrain);
@@ -256,11 +385,11 @@ namespace Level {
 
 			// instantiate elements
 			for (const Bytes::Moving& bytes : root.movings)
-				state.movingPlats.push_back(Moving(&bytes));
+				state.movingPlats.add(&bytes);
 			for (const Bytes::Falling& bytes : root.fallings)
-				state.fallingPlats.push_back(Falling(&bytes));
+				state.fallingPlats.add(&bytes);
 			for (const Bytes::Bumper& bytes : root.bumpers)
-				state.bumpers.push_back(Bumper(&bytes));
+				state.bumpers.add(&bytes);
 			for (const Bytes::Resizer& bytes : root.resizers)
 				state.resizers.push_back(Resizer(&bytes));
 			for (const Bytes::Prism& bytes : root.prisms)
@@ -268,11 +397,20 @@ namespace Level {
 			for (const Bytes::Checkpoint& bytes : root.checks)
 				state.checks.push_back(Checkpoint(&bytes));
 			for (const Bytes::Button& bytes : root.buttons)
-				state.buttons.push_back(Button(&bytes));
+				state.buttons.add(&bytes);
 			for (const Bytes::CameraTrigger& bytes : root.triggers)
 				state.triggers.push_back(CameraTrigger(&bytes));
-			for (const Bytes::DarkCube& bytes : root.darkcubes)
+			for (const Bytes::DarkCube& bytes : root.darkcubes) {
 				state.darkcubes.push_back(DarkCube(&bytes));
+				paths.push_back(&bytes.path);
+			};
+			paths.push_back(NULL);
+
+			// index moving platforms and triggers
+			movingGrid.build(state.movingPlats);
+			triggerGrid.build(root, state.movingPlats);
+			changes.reset(state);
+			history.reset(state);
 		};
 
 		/// Creates a level ranking.
@@ -287,8 +425,11 @@ namespace Level {
 
 		/// Stores initial level state checkpoint.
 		void initCheckpoint() {
-			Models::Space::set(Models::Grad::fromTheme(state.grad), 0.0f);
+			reapply();
 			init = state;
+			last = state;
+			changes.reset(state);
+			history.reset(state);
 			store(root.spawn.int3(), false);
 		};
 
@@ -298,7 +439,7 @@ namespace Level {
 		/// @note Camera will not be reset during restore.
 		/// @warning Must be used after `model()` call.
 		void store(sf::Vector3i pos, bool size) {
-			last = state;
+			commit();
 			checkpoint = pos;
 			lastsize = size;
 			camerastate = camera.store();
@@ -311,7 +452,7 @@ namespace Level {
 		/// @param camera Camera reset position.
 		/// @warning Must be used after `model()` call.
 		void store(sf::Vector3i pos, bool size, vec3x camera) {
-			last = state;
+			commit();
 			checkpoint = pos;
 			lastsize = size;
 			camerastate = this->camera.store();
@@ -319,28 +460,51 @@ namespace Level {
 			camerapos = camera;
 		};
 
+		/// Copies changed elements into last checkpoint state.
+		void commit() {
+			changes.copy(last, state);
+			history.merge(changes);
+			changes.clear();
+		};
+
 		/// Restores level state from last checkpoint.
 		/// @param death Whether the cube has died.
+		/// @note Player keymap is kept, so that replayed input survives a respawn.
 		void restore(bool death) {
-			state = last;
+			KeyMap keys = getPlayer().keys;
+			changes.copy(state, last);
+			changes.clear();
 			getPlayer() = Cube(checkpoint, lastsize, false, true).setEnergy(getPlayer().energy);
+			getPlayer().keys = keys;
 			camera.restore(camerastate);
 			if (camerareset) camera.pos = camerapos.gl();
+			followPrev = camera.pos;
 			if (death) deaths++;
+			reindex();
 			reapply();
 		};
 
 		/// Restores level state to initial.
 		void retry() {
-			state = init;
+			changes.merge(history);
+			changes.copy(state, init);
 			getPlayer() = Cube(root.spawn.int3(), false, false, true);
 			camera.restore(initcamera);
 			camera.pos = root.spawn.gl();
+			followPrev = camera.pos;
 			deaths = 0;
 			timer = Data::Time();
+			reindex();
 			reapply();
 		};
 
+		/// Drives the player with an input path.
+		/// @param path Input path (must outlive the level).
+		void drive(const Bytes::Path* path) {
+			paths.back() = path;
+			getPlayer().keys = KeyMap(path);
+		};
+
 		/// Warps the player to a point of interest.
 		/// @param offset Point of interest offset.
 		/// @return New point of interest index.
@@ -357,9 +521,17 @@ namespace Level {
 			return POI;
 		};
 
+		/// Reindexes moved platforms and attached triggers.
+		void reindex() {
+			movingGrid.update(state.movingPlats);
+			triggerGrid.update(root, state.movingPlats);
+		};
+
 		/// Reapplies current level gradient.
 		void reapply() const {
+			#ifndef HEADLESS
 			Models::Space::set(Models::Grad::fromTheme(state.grad), 0.0f);
+			#endif
 		};
 
 		/// Generates models for elements.
@@ -368,21 +540,27 @@ namespace Level {
 			terrain.model(&root);
 
 			// generate element models
-			for (Moving& moving : state.movingPlats) moving.model();
-			for (Bumper& bumper : state.bumpers)     bumper.model();
+			state.movingPlats.model();
+			state.bumpers.model();
+		};
+
+		/// Updates element models from current state without stepping the simulation.
+		void refresh() {
+			state.movingPlats.refresh();
+			state.bumpers.refresh();
+			for (Cube& cube : state.cubes)
+				cube.update(0.0f, true);
 		};
 
 		/// Updates all level elements.
 		/// @param delta Elapsed time since last frame.
 		/// @param debug Whether to overwrite world map keymaps.
 		void update(float delta, bool debug = false) {
-			// check for no updates
-			if (!Win::updates) return;
-
 			// update elements
-			for (Moving& moving : state.movingPlats)    moving.update(delta);
-			for (Bumper& bumper : state.bumpers)        bumper.update(delta);
-			for (Falling& falling : state.fallingPlats) falling.update(delta);
+			state.movingPlats.update(delta, changes.movingPlats);
+			state.bumpers.update(delta, changes.bumpers);
+			state.fallingPlats.update(delta, changes.fallingPlats);
+			reindex();
 
 			// force cube exit animation
 			if (followLock) anim = 65536.0f;
@@ -391,9 +569,10 @@ namespace Level {
 			std::deque<size_t> dead;
 			for (size_t i = 0; i < state.cubes.size(); i++) {
 				Cube& cube = state.cubes[i];
+				cube.prev = cube.pos();
 
 				// update cube keymap
-				cube.keys.update(state.movingPlats, 1.0f / 60);
+				cube.keys.update(state.movingPlats, delta);
 
 				// update cube position
 				cube.syncOffset(state.movingPlats, i == state.player ? &tick : NULL);
@@ -432,7 +611,7 @@ namespace Level {
 			};
 
 			// update buttons
-			for (Button& button : state.buttons) button.update();
+			state.buttons.update(changes.buttons);
 
 			// update particles
 			state.particles.update(delta);
@@ -441,15 +620,132 @@ namespace Level {
 			camera.update(delta);
 
 			// update level background
+			#ifndef HEADLESS
 			Models::Space::update(delta);
+			#endif
 
 			// update level time
 			if (!getPlayer().inactive())
 				timer.updateGame(delta);
+
+			// store rewind frame
+			steps++;
+			if (timeline.enabled()) capture();
+
+			// write state hash
+			if (trace) fprintf(trace, "%llu %016llx\n", (unsigned long long)steps, (unsigned long long)hash());
 		};
 
-		/// Updates level camera.
+		/// Visits level simulation state.
+		/// @param snap State serializer.
+		/// @note Models, particles, camera and checkpoint states are not visited.
+		/// @note Variable length lists are padded to their maximal length, so frames of a level have the same size.
+		void frame(Snapshot& snap) {
+			// visit elements
+			state.movingPlats.frame(snap);
+			state.fallingPlats.frame(snap);
+			state.bumpers.frame(snap);
+			for (Checkpoint& check : state.checks)    check.frame(snap);
+			state.buttons.frame(snap);
+			for (DarkCube& spawner : state.darkcubes) spawner.frame(snap);
+
+			// visit remaining prisms
+			uint16_t count = state.prisms.size();
+			snap(count);
+			if (snap.loading()) state.prisms.assign(count, Prism(NULL));
+			for (Prism& prism : state.prisms) {
+				uint16_t idx = prism.root - root.prisms.data();
+				snap(idx)(prism.dark);
+				prism.root = &root.prisms[idx];
+			};
+			snap.skip((root.prisms.size() - count) * (sizeof(uint16_t) + sizeof(bool)));
+
+			// visit cubes
+			size_t slots = root.darkcubes.size() + 1;
+			count = state.cubes.size();
+			snap(count);
+			if (snap.loading()) {
+				while (state.cubes.size() > count) state.cubes.pop_back();
+				while (state.cubes.size() < count) state.cubes.push_back(Cube({0, 0, 0}, false, false, false));
+			};
+			for (Cube& cube : state.cubes) cube.frame(snap, paths);
+			if (count < slots) {
+				Snapshot size(Snapshot::Measure);
+				getPlayer().frame(size, paths);
+				snap.skip((slots - count) * size.size());
+			};
+
+			// visit hang timers
+			count = hang.size();
+			snap(count);
+			if (snap.loading()) hang.clear();
+			for (uint16_t i = 0; i < count; i++) {
+				std::pair<size_t, float> entry;
+				if (!snap.loading()) entry = *std::next(hang.begin(), i);
+				snap(entry.first)(entry.second);
+				if (snap.loading()) hang.insert(entry);
+			};
+			if (count < slots) snap.skip((slots - count) * (sizeof(size_t) + sizeof(float)));
+
+			// visit state values
+			snap(state.player)(state.last)(state.lock)(state.prism)(state.grad);
+			snap(deaths)(anim)(tick)(timer)(firstcontact)(followLock)(exitReq)(steps);
+		};
+
+		/// Returns a hash of level simulation state.
+		/// @note Pointers and padding are not hashed, so equal states hash equally in different runs and builds.
+		uint64_t hash() {
+			Snapshot snap(Snapshot::Hash);
+			frame(snap);
+			return snap.hash();
+		};
+
+		/// Saves simulation state.
+		/// @param data Snapshot buffer.
+		void save(std::vector<uint8_t>& data) {
+			Snapshot snap(Snapshot::Save, &data);
+			frame(snap);
+			snap.finish();
+		};
+
+		/// Loads simulation state.
+		/// @param data Snapshot buffer.
+		/// @note Checkpoint states are kept.
+		void load(std::vector<uint8_t>& data) {
+			Snapshot snap(Snapshot::Load, &data);
+			frame(snap);
+			changes.fill();
+			reindex();
+		};
+
+		/// Stores current state in the rewind buffer.
+		void capture() {
+			#ifdef HEADLESS
+			sf::Clock clock;
+			#endif
+			save(snapshot);
+			timeline.push(snapshot);
+			#ifdef HEADLESS
+			captureTime += clock.getElapsedTime();
+			captures++;
+			#endif
+		};
+
+		/// Rewinds the simulation.
+		/// @param ticks Tick count to rewind.
+		/// @return Actual rewound tick count.
+		/// @note Checkpoint states are kept.
+		size_t rewind(size_t ticks) {
+			if (timeline.size() == 0) return 0;
+			ticks = timeline.seek(ticks, snapshot);
+			load(snapshot);
+			followPrev = camera.pos;
+			return ticks;
+		};
+
+		/// Moves level camera towards the player.
 		/// @param offset Additional camera offset.
+		/// @note Should be called once per simulation step.
 		void follow(glm::vec3 offset) {
 			Cube& cube = getPlayer();
 			if (cube.mod_cube == NULL)
@@ -468,48 +764,66 @@ namespace Level {
 
 			// update camera position
 			glm::vec3 diff = followPos + offset - camera.pos;
+			followPrev = camera.pos;
 			camera.pos += diff * speed;
+		};
 
-			// update camera matrix
+		/// Sends level camera to shaders.
+		/// @param alpha Interpolation factor between simulation steps.
+		void look(float alpha = 1.0f) {
+			// calculate interpolated camera matrix
+			glm::vec3 pos = camera.pos;
+			camera.pos = lerpv(followPrev, pos, alpha);
 			camera.recalculate();
-			camera.uniform(Shaders::tex, "camera");
+			camera.pos = pos;
+
+			// send camera matrix
+			camera.uniform();
 		};
 
 		/// Returns player cube.
 		Cube& getPlayer() { return state.cubes[state.player]; };
 
-		/// Renders the level.
+		/// Queues the level for rendering.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t draw() {
+		/// @note Queued draws are executed in `RenderQueue::Color` pass.
+		size_t draw(float alpha = 1.0f) {
 			// draw terrain
-			Assets::terrain.bind();
-			size_t vertcount = terrain.draw();
+			size_t vertcount = terrain.draw(camera.frustum());
 
-			// draw exit
-			Assets::mask.bind();
+			// queue exit
 			vertcount += Models::drawExit(root.exit.gl());
 
 			// draw elements
-			for (Moving& moving : state.movingPlats)    vertcount += moving.draw();
-			for (Falling& falling : state.fallingPlats) vertcount += falling.draw();
-			for (Bumper& bumper : state.bumpers)        vertcount += bumper.draw();
-			for (Resizer& resizer : state.resizers)     vertcount += resizer.draw();
-			for (Prism& prism : state.prisms)           vertcount += prism.draw();
-			for (Button& button : state.buttons)        vertcount += button.draw(state.movingPlats);
-			for (Cube& cube : state.cubes)              vertcount += cube.draw();
+			vertcount += state.movingPlats.draw(alpha);
+			vertcount += state.fallingPlats.draw(alpha);
+			vertcount += state.bumpers.draw();
+			for (Resizer& resizer : state.resizers) vertcount += resizer.draw();
+			for (Prism& prism : state.prisms)       vertcount += prism.draw();
+			vertcount += state.buttons.draw(state.movingPlats, alpha);
+
+			// draw queued element instances
+			Models::Instances::flush(RenderQueue::Color);
+
+			// draw cubes
+			for (Cube& cube : state.cubes) vertcount += cube.draw(alpha);
 
 			// draw particles
 			return vertcount + state.particles.draw();
 		};
 
-		/// Renders level shadows.
+		/// Queues level shadows for rendering.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t shadow() {
+		/// @note Queued draws are executed in `RenderQueue::Shadow` pass.
+		size_t shadow(float alpha = 1.0f) {
 			size_t vertcount = 0;
 
 			// draw shadows
 			for (Prism& prism : state.prisms) vertcount += prism.shadow();
-			for (Cube& cube : state.cubes)    vertcount += cube.shadow();
+			Models::Instances::flush(RenderQueue::Shadow);
+			for (Cube& cube : state.cubes)    vertcount += cube.shadow(alpha);
 			return vertcount;
 		};
 
@@ -518,15 +832,7 @@ namespace Level {
 		/// @param type Whether to check for only full blocks.
 		/// @param mini Platform check type.
 		bool platmini(sf::Vector3i pos, bool type, bool mini) const {
-			if (pos.x < 0 || pos.y < 0 || pos.z < 0) return false;
-			Block::Type block = terrain.root.at(pos / 3).type();
-			if (block == Block::Half && mini) switch (pos.z % 3) {
-				case 0: block = Block::None; break;
-				case 1: block = Block::Half; break;
-				case 2: block = Block::Full; break;
-				default: break;
-			};
-			return type ? block == Block::Full : block != Block::None;
+			return terrain.bits.solid(pos, type, mini);
 		};
 
 		/// Checks if a solid exists at the mini-position.
@@ -542,9 +848,9 @@ namespace Level {
 			vol3x cube = vol3x(vec3x(size)) + pos / 3fx;
 
 			// check for moving platforms
-			for (size_t i = 0; i < state.movingPlats.size(); i++) {
-				if (state.movingPlats[i].volume().intersects(cube)) {
-					vec3x diff = state.movingPlats[i].now - pos / 3fx;
+			for (size_t i : movingGrid.query(cube)) {
+				if (state.movingPlats.volume(i).intersects(cube)) {
+					vec3x diff = state.movingPlats.now[i] - pos / 3fx;
 					if (!aligned(diff.x, mini) || !aligned(diff.y, mini))
 						source = -1ULL;
 					else source = i;
@@ -559,9 +865,10 @@ namespace Level {
 			};
 
 			// check for falling platforms
-			for (const Falling& falling : state.fallingPlats) {
-				if (!falling.active()) continue;
-				if (falling.pos.int3() == pos.int3() / 3) {
+			const FallingPlats& fallings = state.fallingPlats;
+			for (size_t i = 0; i < fallings.size(); i++) {
+				if (!fallings.active(i)) continue;
+				if (fallings.pos[i].int3() == pos.int3() / 3) {
 					Block::Type block = Block::Half;
 					if (mini) switch ((int)pos.z % 3) {
 						case 0: block = Block::None; break;
@@ -588,15 +895,16 @@ namespace Level {
 			vol3x cube = vol3x(vec3x(size)) + pos / 3fx;
 
 			// check for platforms
-			for (const Moving& moving : state.movingPlats) {
-				if (moving.volume().intersects(cube)) {
+			for (size_t i : movingGrid.query(cube)) {
+				vol3x volume = state.movingPlats.volume(i);
+				if (volume.intersects(cube)) {
 					// get distance between cube and platform
 					fix dist = 0fx;
 					switch (dir) {
-						case East : dist = moving.volume().pos.x - dist;   break;
-						case West : dist = dist - moving.volume().out().x; break;
-						case North: dist = moving.volume().pos.y - dist;   break;
-						case South: dist = dist - moving.volume().out().y; break;
+						case East : dist = volume.pos.x - dist;   break;
+						case West : dist = dist - volume.out().x; break;
+						case North: dist = volume.pos.y - dist;   break;
+						case South: dist = dist - volume.out().y; break;
 					};
 
 					// check if distance is unaligned
@@ -616,13 +924,13 @@ namespace Level {
 			vol3x region = state.cubes[i].volume;
 
 			// get base velocity
-			vec3x base = state.cubes[i].rel == -1ULL ? vec3x(0) : state.movingPlats[state.cubes[i].rel].velocity();
+			vec3x base = state.cubes[i].rel == -1ULL ? vec3x(0) : state.movingPlats.velocity(state.cubes[i].rel);
 
 			// get moving platform colliders
-			for (size_t i = 0; i < state.movingPlats.size(); i++) {
-				const Moving& moving = state.movingPlats[i];
-				if (moving.volume().intersects(region))
-					list.push_back(Collision { moving.volume(), moving.velocity() - base, i });
+			for (size_t i : movingGrid.query(region)) {
+				vol3x volume = state.movingPlats.volume(i);
+				if (volume.intersects(region))
+					list.push_back(Collision { volume, state.movingPlats.velocity(i) - base, i });
 			};
 
 			// get terrain block ranges
@@ -630,16 +938,18 @@ namespace Level {
 			sf::Vector3i max = region.out().up3();
 
 			// get terrain colliders
+			int count = max.x - min.x + 1;
 			for (int z = min.z; z <= max.z; z++) {
 				for (int y = min.y; y <= max.y; y++) {
-					for (int x = min.x; x <= max.x; x++) {
-						// get block
-						Bytes::Block block = terrain.root.at({x, y, z});
-						if (block.type() == Bytes::Block::None)
-							continue;
-
-						// add block collider
-						vol3x volume = block.volume() + vec3x(x, y, z);
+					// get occupied blocks in row
+					uint64_t full = terrain.bits.row({min.x, y, z}, count, true);
+					uint64_t half = terrain.bits.row({min.x, y, z}, count, false);
+
+					// add block colliders
+					for (uint64_t mask = full | half; mask; mask &= mask - 1) {
+						int bit = __builtin_ctzll(mask);
+						Bytes::Block block = (full >> bit & 1) ? Bytes::Block::Full : Bytes::Block::Half;
+						vol3x volume = block.volume() + vec3x(min.x + bit, y, z);
 						if (volume.intersects(region))
 							list.push_back(Collision { volume, vec3x(0) - base, -1ULL });
 					};
@@ -753,12 +1063,14 @@ namespace Level {
 				cube.energy = approach(cube.energy, 0fx, cube.moving() ? (T / 1500fx) : (T / 2000fx));
 
 			// update cube rainbow timer
+			#ifndef HEADLESS
 			if (id == state.player) {
 				if (world)
 					Timers::cube.set(7500);
 				else
 					Timers::cube.set(10000 - int(cube.energy * 9500fx));
 			};
+			#endif
 
 			// up vector
 			const int unit = cube.settings.mini ? 1 : 3;
@@ -919,10 +1231,11 @@ namespace Level {
 			};
 
 			// check for active bumpers
-			for (Bumper& bumper : state.bumpers) {
-				if (bumper.in(cube.volume) && cube.grid() == bumper.root->pos + vec3x::fromDir(bumper.root->dir)) {
+			for (size_t i : triggerGrid.at(cube.grid()).bumpers) {
+				const Bytes::Bumper& bumper = *state.bumpers.root[i];
+				if (state.bumpers.in(i, cube.volume) && cube.grid() == bumper.pos + vec3x::fromDir(bumper.dir)) {
 					// create bump time
-					cube.bump = bumper.root->power;
+					cube.bump = bumper.power;
 
 					// calculate bump impulse
 					fix speed = 0fx;
@@ -933,12 +1246,12 @@ namespace Level {
 					};
 
 					// apply speed
-					glm::vec2 dir = directionVec(bumper.root->dir);
+					glm::vec2 dir = directionVec(bumper.dir);
 					cube.speed.x = (fix)dir.x * speed;
 					cube.speed.y = (fix)dir.y * speed;
 
 					// set cube state
-					cube.dir = bumper.root->dir;
+					cube.dir = bumper.dir;
 					cube.act = Cube::Roll;
 					Assets::sfx(Assets::Bump);
 				};
@@ -965,9 +1278,12 @@ namespace Level {
 					return;
 				};
 
+				// get nearby triggers
+				const Triggers::Cell* cell = &triggerGrid.at(cube.grid());
+
 				// check for camera triggers
 				if (id == state.player && !cube.inactive()) {
-					for (size_t i = 0; i < state.triggers.size(); i++) {
+					for (size_t i : cell->triggers) {
 						// ignore if active
 						if (i == state.last) continue;
 						const CameraTrigger& trigger = state.triggers[i];
@@ -984,10 +1300,12 @@ namespace Level {
 				};
 
 				// check for dark cube spawners
-				for (DarkCube& spawner : state.darkcubes) {
+				for (size_t i : cell->darkcubes) {
+					DarkCube& spawner = state.darkcubes[i];
 					if (spawner.active && inside(spawner.root->pos, spawner.root->rad, cube.grid())) {
 						// disable spawner
 						spawner.active = false;
+						changes.darkcubes.mark(i);
 
 						// create dark cube
 						Cube darkcube(spawner.root->spawn.int3(), spawner.root->mini, spawner.root->dark, false);
@@ -999,19 +1317,23 @@ namespace Level {
 
 				// check for checkpoints
 				if (id == state.player) {
-					for (Checkpoint& check : state.checks) {
+					for (size_t i : cell->checks) {
+						Checkpoint& check = state.checks[i];
 						if (check.active && inside(check.root->pos, check.root->rad, cube.grid())) {
 							// setup background gradient
 							if (check.root->time != 0) {
+								#ifndef HEADLESS
 								Models::Space::set(
 									Models::Grad::fromTheme(check.root->theme),
 									convTicks(check.root->time)
 								);
+								#endif
 								state.grad = check.root->theme;
 							};
 
 							// store level state
 							check.active = false;
+							changes.checks.mark(i);
 							if (check.root->reset)
 								store(check.root->rsp.int3(), cube.settings.mini, check.root->rsp);
 							else
@@ -1021,37 +1343,44 @@ namespace Level {
 					};
 				};
 
+				// release buttons left by the cube
+				Buttons& buttons = state.buttons;
+				for (size_t k = 0; k < buttons.held.size();) {
+					const size_t i = buttons.held[k];
+					if (inside(buttons.pos(i, state.movingPlats), buttons.root[i]->rad, cube.grid())) { k++; continue; };
+					changes.buttons.mark(i);
+					buttons.release(k);
+				};
+
 				// check for buttons
-				for (Button& button : state.buttons) {
-					// get button position
-					vec3x pos = button.root->attached
-						? state.movingPlats[button.root->moving].now + vec3x(0, 0, 1)
-						: button.root->pos;
+				for (size_t i : cell->buttons) {
+					const Bytes::Button& button = *buttons.root[i];
 
 					// check for button press
-					if (inside(pos, button.root->rad, cube.grid())) {
-						button.pressed = true;
+					if (inside(buttons.pos(i, state.movingPlats), button.rad, cube.grid())) {
+						if (buttons.press(i)) changes.buttons.mark(i);
 
 						// ignore if button is already pressed
-						if (button.state) continue;
+						if (buttons.state[i]) continue;
 
 						// press the button
-						button.state = true;
-						if (button.root->visible) Assets::sfx(Assets::Button);
+						buttons.state[i] = true;
+						if (button.visible) Assets::sfx(Assets::Button);
 
 						// lock camera
-						if (button.root->camera)
-							state.lock = button.root->lock == 0xFFFF ? -1ULL : button.root->lock;
+						if (button.camera)
+							state.lock = button.lock == 0xFFFF ? -1ULL : button.lock;
 
 						// execute button commands
-						button.execute(state.movingPlats, state.buttons, state.bumpers);
-						continue;
+						buttons.execute(i, state.movingPlats, state.bumpers);
+						touch(button);
 					};
-					button.pressed = false;
 				};
 
 				// check for teleporters
-				for (const Bytes::Teleport& port : root.ports) {
+				for (size_t k = 0; k < cell->ports.size(); k++) {
+					const uint16_t i = cell->ports[k];
+					const Bytes::Teleport& port = root.ports[i];
 					if (inside(port.pos, port.rad, cube.grid())) {
 						cube.attach(state.movingPlats, -1ULL);
 
@@ -1060,10 +1389,15 @@ namespace Level {
 
 						// translate player
 						cube.tile = port.tp;
+						cube.settle();
 
 						// translate camera
 						if (id == state.player && state.lock == -1ULL)
 							camera.pos += off.gl();
+
+						// continue with following teleporters near destination
+						cell = &triggerGrid.at(cube.grid());
+						k = std::upper_bound(cell->ports.begin(), cell->ports.end(), i) - cell->ports.begin() - 1;
 					};
 				};
 
@@ -1071,10 +1405,11 @@ namespace Level {
 				if (cube.bump) { cube.bump--; ignorefall = cube.bump >= 1; };
 
 				// check for falling platform
-				for (Falling& falling : state.fallingPlats) {
-					if (falling.pos + vec3x(0, 0, 1) == cube.grid()) {
+				for (size_t i : cell->fallings) {
+					if (state.fallingPlats.pos[i] + vec3x(0, 0, 1) == cube.grid()) {
 						// trigger falling platform
-						falling.trigger();
+						changes.fallingPlats.mark(i);
+						state.fallingPlats.trigger(i);
 					};
 				};
 
@@ -1094,7 +1429,9 @@ namespace Level {
 				};
 
 				// check for resizer
-				for (const Resizer& resizer : state.resizers) {
+				cell = &triggerGrid.at(cube.grid());
+				for (size_t i : cell->resizers) {
+					const Resizer& resizer = state.resizers[i];
 					if (inside(resizer.root->pos, resizer.root->rad, cube.grid())) {
 						// ignore if cube size matches
 						if (resizer.root->shrinks() == cube.settings.mini)
@@ -1307,6 +1644,7 @@ namespace Level {
 						addsplit(cube.tile, cube.mini, offi);
 						cube.act = Cube::Idle;
 						cube.t = 0fx;
+						cube.settle();
 
 						// reset momentum
 						if (!(dx == 0fx && dy == 0fx) && directionFromSteer(dx, dy) != cube.dir) {
@@ -1329,6 +1667,7 @@ namespace Level {
 						cube.act = Cube::Fall;
 						cube.t = 0fx;
 						addsplit(cube.tile, cube.mini, up.int3());
+						cube.settle();
 
 						// prepare roll transition
 						if (cube.settings.mini) {
@@ -1370,12 +1709,21 @@ namespace Level {
 					// remove prism
 					else {
 						state.prisms.erase(state.prisms.begin() + i);
+						changes.prisms = true;
 						cube.energy = 1fx;
 					};
 				};
 			};
 		};
 
+		/// Marks elements changed by button commands.
+		/// @param button Executed button data.
+		void touch(const Bytes::Button& button) {
+			for (const Bytes::MovingCommand cmd : button.movings) changes.movingPlats.mark(cmd.id);
+			for (const Bytes::ButtonCommand cmd : button.buttons) changes.buttons.mark(cmd.id);
+			for (const Bytes::BumperCommand cmd : button.bumpers) changes.bumpers.mark(cmd.id);
+		};
+
 		/// Processes route collection effects.
 		/// @param routes Routes collection.
 		/// @param active List of active level numbers.
@@ -1383,15 +1731,43 @@ namespace Level {
 			// activate appropriate buttons
 			for (uint16_t idx : active) {
 				for (uint16_t btn : routes.routes[idx].buttons) {
-					state.buttons[btn].proc(state.movingPlats, state.buttons, state.bumpers);
-					state.buttons[btn].state = true;
+					state.buttons.proc(btn, state.movingPlats, state.bumpers);
+					state.buttons.state[btn] = true;
+					changes.buttons.mark(btn);
+					touch(*state.buttons.root[btn]);
 				};
 			};
 
 			// recolor prisms
-			for (uint16_t idx : routes.dark_prisms)
-				if (idx < state.prisms.size())
+			for (uint16_t idx : routes.dark_prisms) {
+				if (idx < state.prisms.size()) {
 					state.prisms[idx].dark = true;
+					changes.prisms = true;
+				};
+			};
+
+			// reindex moved platforms
+			reindex();
+		};
+
+		/// Returns a random integer from level generator.
+		uint32_t random() {
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			return seed;
+		};
+
+		/// Generates a random float in [-1, 1] from level generator.
+		float noise() {
+			return (random() >> 8) * (2.0f / 0xFFFFFF) - 1.0f;
+		};
+
+		/// Generates a random float in [a, b] from level generator.
+		/// @param a Minimal value.
+		/// @param b Maximal value.
+		float noiseRange(float a, float b) {
+			return lerpf(a, b, (random() >> 8) / (float)0xFFFFFF);
 		};
 
 		/// Creates a crush animation.
@@ -1409,20 +1785,20 @@ namespace Level {
 						Dust dust;
 						dust.pos = Accel<glm::vec3>(
 							glm::vec3(
-								x / 2.0f + uniform() * 0.25f,
-								y / 2.0f + uniform() * 0.25f,
-								z / 2.0f + uniform() * 0.25f
+								x / 2.0f + noise() * 0.25f,
+								y / 2.0f + noise() * 0.25f,
+								z / 2.0f + noise() * 0.25f
 							) + offset,
 							glm::vec3(
-								x / 2.0f + uniform() * 0.25f,
-								y / 2.0f + uniform() * 0.25f,
-								z / 2.0f + uniform() * 0.25f
+								x / 2.0f + noise() * 0.25f,
+								y / 2.0f + noise() * 0.25f,
+								z / 2.0f + noise() * 0.25f
 							) * 5.0f,
 							glm::vec3(0.0f)
 						);
 						dust.dim = Accel<float>(0.5, -1, -0.25);
-						dust.off = rand() & 0xFF;
-						dust.mode = (rand() % 3) + (cube.dark ? 3 : 0);
+						dust.off = random() & 0xFF;
+						dust.mode = (random() % 3) + (cube.dark ? 3 : 0);
 						state.particles.add(dust);
 					};
 				};
@@ -1444,16 +1820,16 @@ namespace Level {
 						Dust dust;
 						dust.pos = Accel<glm::vec3>(
 							glm::vec3(x / 6.0f, y / 6.0f, z / 6.0f) + offset,
-							glm::vec3(0.0f, uniformRange(0.1f, 3.0f), 0.0f),
+							glm::vec3(0.0f, noiseRange(0.1f, 3.0f), 0.0f),
 							glm::vec3(0.0f)
 						);
 						dust.dim = Accel<float>(
-							0.5 + uniform() * 0.1,
-							-uniformRange(0.06f, 0.3f),
+							0.5 + noise() * 0.1,
+							-noiseRange(0.06f, 0.3f),
 							0.0f
 						);
-						dust.off = rand() & 0xFF;
-						dust.mode = (rand() % 3) + (cube.dark ? 3 : 0);
+						dust.off = random() & 0xFF;
+						dust.mode = (random() % 3) + (cube.dark ? 3 : 0);
 						state.particles.add(dust);
 					};
 				};
@@ -1465,20 +1841,20 @@ namespace Level {
 						Dust dust;
 						dust.pos = Accel<glm::vec3>(
 							glm::vec3(
-								x / 2.0f + uniform() * 0.25f,
-								y / 2.0f + uniform() * 0.25f,
-								z / 2.0f + uniform() * 0.25f
+								x / 2.0f + noise() * 0.25f,
+								y / 2.0f + noise() * 0.25f,
+								z / 2.0f + noise() * 0.25f
 							) + offset,
 							glm::vec3(
-								x / 2.0f + uniform() * 0.25f,
-								y / 2.0f + uniform() * 0.25f,
-								z / 2.0f + uniform() * 0.25f
+								x / 2.0f + noise() * 0.25f,
+								y / 2.0f + noise() * 0.25f,
+								z / 2.0f + noise() * 0.25f
 							) * 2.0f,
 							glm::vec3(0.0f)
 						);
 						dust.dim = Accel<float>(0.5, -1, -0.25);
-						dust.off = rand() & 0xFF;
-						dust.mode = (rand() % 3) + (cube.dark ? 3 : 0);
+						dust.off = random() & 0xFF;
+						dust.mode = (random() % 3) + (cube.dark ? 3 : 0);
 						state.particles.add(dust);
 					};
 				};
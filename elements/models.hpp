@@ -0,0 +1,60 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Element model list.
+	/// @note Models belong to a single list, so lists can only be moved.
+	class ModelList {
+		private:
+		/// Model objects.
+		std::vector<Object*> list;
+
+		public:
+		/// Empty list constructor.
+		ModelList () {};
+		/// Copy constructor.
+		/// @param models Copied model list.
+		ModelList (const ModelList& models) = delete;
+		/// Move constructor.
+		/// @param models Moved model list.
+		ModelList (ModelList&& models): list(std::move(models.list)) {
+			models.list.clear();
+		};
+		/// Copy assignment.
+		/// @param models Copied model list.
+		ModelList& operator=(const ModelList& models) = delete;
+		/// Move assignment.
+		/// @param models Moved model list.
+		ModelList& operator=(ModelList&& models) {
+			if (this == &models) return *this;
+			clear();
+			list = std::move(models.list); models.list.clear();
+			return *this;
+		};
+
+		/// Model list destructor.
+		~ModelList () { clear(); };
+
+		/// Deletes all models.
+		void clear() {
+			for (Object* object : list) delete object;
+			list.clear();
+		};
+
+		/// Replaces all models with new empty objects.
+		/// @param count Model count.
+		/// @param packed Whether models are stored in packed vertex format.
+		void generate(size_t count, bool packed = false) {
+			clear();
+			for (size_t i = 0; i < count; i++)
+				list.push_back(new Object(GL_TRIANGLES, packed));
+		};
+
+		/// Checks whether models were generated.
+		bool empty() const { return list.empty(); };
+
+		/// Returns element model.
+		/// @param idx Element index.
+		Object& operator[](size_t idx) const { return *list[idx]; };
+	};
+};
\ No newline at end of file
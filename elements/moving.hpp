@@ -2,181 +2,366 @@
 
 /// Level related namespace.
 namespace Level {
-	/// Moving platform object.
-	struct Moving {
-		/// Moving platform data.
-		const Bytes::Moving* root;
+	/// Moving platform waypoint timeline.
+	/// @note Waypoint spans are rounded up to whole simulation steps, since waypoint timers restart on each switch.
+	/// @note Button procs restart waypoint timers, so a timeline covers platform motion between procs only.
+	struct Timeline {
+		/// Waypoint chain result of a proc.
+		struct Proc {
+			uint16_t prev; // Waypoint switched from before the last switch, or `0xffff` if there was a single switch.
+			uint16_t from; // Waypoint switched from by the last switch.
+			uint16_t   to; // Final waypoint.
+		};
+
+		std::vector<uint32_t> begin; // Waypoint offsets from the first waypoint in ticks.
+		std::vector<uint32_t>  span; // Waypoint spans in ticks.
+		std::vector<uint16_t>   end; // Last waypoint of each consecutive waypoint run.
+		std::vector<Proc>     procs; // Proc results of each waypoint.
 
-		vec3x   now; // Current position.
-		vec3x  prev; // Previous position.
-		vec3x start; // Waypoint start.
+		/// Empty timeline constructor.
+		Timeline () {};
 
-		uint16_t waypoint = 0xffff; // Waypoint pointer.
-		float        time = 0;      // Current waypoint time.
+		/// Precomputes a waypoint timeline.
+		/// @param ways Waypoint list.
+		Timeline (const std::vector<Bytes::Waypoint>& ways) {
+			const size_t count = ways.size();
 
-		/// Platform object.
-		Object* object = NULL;
-		/// Previous active value.
-		bool pactive;
-		/// Whether the platform is active.
-		bool active;
+			// accumulate waypoint spans
+			uint32_t offset = 0;
+			for (const Bytes::Waypoint& way : ways) {
+				uint32_t steps = (uint32_t)((way.total + stepTicks - 1) / stepTicks);
+				begin.push_back(offset);
+				span.push_back(std::max(steps, 1U) * stepTicks);
+				offset += span.back();
+			};
 
-		/// Moving platform destructor.
-		~Moving () { if (object) delete object; };
+			// find ends of consecutive runs
+			end.resize(count);
+			for (size_t i = count; i-- > 0;)
+				end[i] = next(ways, i) == i + 1 ? end[i + 1] : i;
 
-		/// Structure constructor.
-		/// @param data Moving platform data.
-		Moving (const Bytes::Moving* data): root(data) {
-			start = data->start;
-			waypoint = data->active ? 0 : 0xffff;
-			pactive = false;
-			active = false;
+			// resolve waypoint chains
+			for (size_t i = 0; i < count; i++) {
+				Proc proc = { 0xffff, (uint16_t)i, next(ways, i) };
+				for (size_t n = 0; n < count && proc.to != 0xffff && proc.to != i; n++) {
+					proc.prev = proc.from;
+					proc.from = proc.to;
+					proc.to = next(ways, proc.to);
+				};
+				procs.push_back(proc);
+			};
 		};
 
-		/// Copy constructor.
-		/// @param plat Copied moving platform object.
-		/// @note Copy will ignore model pointer.
-		Moving (const Moving& plat):
-			root(plat.root),
-			now(plat.now),
-			prev(plat.prev),
-			start(plat.start),
-			waypoint(plat.waypoint),
-			time(plat.time),
-			active(plat.active) {};
+		/// Returns waypoint selected after another one.
+		/// @param ways Waypoint list.
+		/// @param way Finished waypoint ID.
+		/// @note Running past the last waypoint halts the platform.
+		static uint16_t next(const std::vector<Bytes::Waypoint>& ways, size_t way) {
+			switch (ways[way].after) {
+				case Bytes::Waypoint::Next: return way + 1 < ways.size() ? way + 1 : 0xffff;
+				case Bytes::Waypoint::Loop: return 0;
+				default: return 0xffff;
+			};
+		};
+
+		/// Returns waypoint loop period in ticks.
+		/// @param ways Waypoint list.
+		/// @note Returns 0 if the first waypoint run halts.
+		uint32_t period(const std::vector<Bytes::Waypoint>& ways) const {
+			if (ways.empty() || ways[end[0]].after != Bytes::Waypoint::Loop) return 0;
+			return begin[end[0]] + span[end[0]];
+		};
+	};
+
+	/// Moving platform list.
+	/// @note Simulation fields are stored in separate arrays, so per-tick kernels stream only over hot data.
+	/// @note Boolean fields are stored as bytes, since `std::vector<bool>` elements cannot be referenced.
+	struct MovingPlats {
+		std::vector<const Bytes::Moving*> root; // Moving platform data.
+		std::vector<uint8_t>              half; // Whether platforms are half blocks.
+
+		std::vector<vec3x>      now; // Current positions.
+		std::vector<vec3x>     prev; // Previous positions.
+		std::vector<vec3x>    start; // Waypoint starts.
+		std::vector<uint16_t> waypoint; // Waypoint pointers.
+		std::vector<uint32_t>  time; // Current waypoint times in ticks.
+		std::vector<uint8_t> pactive; // Previous active values.
+		std::vector<uint8_t>  active; // Whether platforms are active.
 
+		/// Platform waypoint timelines.
+		std::vector<Timeline> timelines;
+		/// Platform models.
+		ModelList objects;
+
+		/// Empty list constructor.
+		MovingPlats () {};
+		/// Copy constructor.
+		/// @param plats Copied platform list.
+		/// @note Copy will ignore models.
+		MovingPlats (const MovingPlats& plats):
+			root(plats.root), half(plats.half), now(plats.now), prev(plats.prev), start(plats.start),
+			waypoint(plats.waypoint), time(plats.time), pactive(plats.pactive), active(plats.active),
+			timelines(plats.timelines) {};
+		/// Move constructor.
+		/// @param plats Moved platform list.
+		MovingPlats (MovingPlats&& plats) = default;
 		/// Copy assignment.
-		/// @param plat Copied moving platform object.
-		/// @note Copy will ignore model pointer.
-		Moving& operator=(const Moving& plat) {
-			root = plat.root;
-			now = plat.now;
-			prev = plat.prev;
-			start = plat.start;
-			waypoint = plat.waypoint;
-			time = plat.time;
-			active = plat.active;
+		/// @param plats Copied platform list.
+		/// @note Copy will ignore models, so assigned list keeps its own ones.
+		MovingPlats& operator=(const MovingPlats& plats) {
+			root = plats.root;
+			half = plats.half;
+			now = plats.now;
+			prev = plats.prev;
+			start = plats.start;
+			waypoint = plats.waypoint;
+			time = plats.time;
+			pactive = plats.pactive;
+			active = plats.active;
+			timelines = plats.timelines;
 			return *this;
 		};
+		/// Move assignment.
+		/// @param plats Moved platform list.
+		MovingPlats& operator=(MovingPlats&& plats) = default;
 
-		/// Generates a moving platform model.
+		/// Returns platform count.
+		size_t size() const { return root.size(); };
+
+		/// Adds a moving platform.
+		/// @param data Moving platform data.
+		void add(const Bytes::Moving* data) {
+			root.push_back(data);
+			half.push_back(data->half);
+			now.push_back(vec3x());
+			prev.push_back(vec3x());
+			start.push_back(data->start);
+			waypoint.push_back(data->active ? 0 : 0xffff);
+			time.push_back(0);
+			pactive.push_back(false);
+			active.push_back(false);
+			timelines.push_back(Timeline(data->ways));
+		};
+
+		/// Copies platform state from another list.
+		/// @param idx Platform index.
+		/// @param src Source platform list.
+		void copy(size_t idx, const MovingPlats& src) {
+			now[idx] = src.now[idx];
+			prev[idx] = src.prev[idx];
+			start[idx] = src.start[idx];
+			waypoint[idx] = src.waypoint[idx];
+			time[idx] = src.time[idx];
+			pactive[idx] = src.pactive[idx];
+			active[idx] = src.active[idx];
+		};
+
+		/// Generates moving platform models.
+		/// @note Platforms stay on float vertices, since their shade offset moves UVs out of `[0, 1]` range.
 		void model() {
-			delete object; object = new Object;
-			Models::Moving::platform(*object, root->theme, root->half);
+			objects.generate(size());
+			for (size_t i = 0; i < size(); i++)
+				Models::Moving::platform(objects[i], root[i]->theme, root[i]->half);
 		};
 
-		/// Starts to move the platform from a waypoint.
+		/// Starts to move a platform from a waypoint.
+		/// @param idx Platform index.
 		/// @param way Waypoint ID.
-		void move(uint16_t way) {
-			if (time != 0.0f) {
-				start = now;
-				time = 0.0f;
+		void move(size_t idx, uint16_t way) {
+			if (time[idx] != 0) {
+				start[idx] = now[idx];
+				time[idx] = 0;
 			};
-			waypoint = way;
+			waypoint[idx] = way;
 		};
 
 		/// Sets waypoint and executes all commands until halted.
+		/// @param idx Platform index.
 		/// @param way Waypoint ID.
 		/// @note If an infinite loop is detected, execution will halt at the specified waypoint.
-		void proc(uint16_t way) {
+		/// @note Waypoint chain is resolved by the timeline, so only the last 2 switches are applied.
+		void proc(size_t idx, uint16_t way) {
 			// start moving
-			move(way);
+			move(idx, way);
 
-			// proc updates until halt
-			while (true) {
-				update(0.0f, true);
-				if (waypoint == 0xffff || waypoint == way)
-					break;
+			// apply switch preceding the last one
+			const Timeline::Proc& res = timelines[idx].procs[way];
+			if (res.prev != 0xffff) {
+				start[idx] = root[idx]->ways[res.prev].dest;
+				waypoint[idx] = res.from;
+				time[idx] = 0;
+				place(idx);
 			};
+
+			// apply last switch
+			prev[idx] = now[idx];
+			pactive[idx] = active[idx];
+			start[idx] = root[idx]->ways[res.from].dest;
+			waypoint[idx] = res.to;
+			time[idx] = 0;
+			place(idx);
 		};
 
-		/// Checks whether the platform got paused.
-		bool paused() const { return pactive && !active; };
+		/// Visits platform simulation state.
+		/// @param snap State serializer.
+		void frame(Snapshot& snap) {
+			for (size_t i = 0; i < size(); i++)
+				snap(now[i])(prev[i])(start[i])(waypoint[i])(time[i])(pactive[i])(active[i]);
+		};
 
-		/// Update moving platform state.
-		/// @param delta Elapsed time since last frame.
-		/// @param proc Whether to immediately process the waypoint.
-		void update(float delta, bool proc = false) {
-			prev = now;
-			pactive = active;
+		/// Checks whether updates leave a platform unchanged.
+		/// @param idx Platform index.
+		bool idle(size_t idx) const {
+			return waypoint[idx] == 0xffff && !active[idx] && !pactive[idx]
+				&& prev[idx] == now[idx] && now[idx] == start[idx];
+		};
 
-			// update waypoint
-			if (waypoint != 0xffff) {
-				// update waypoint timer
-				time += delta;
+		/// Checks whether a platform got paused.
+		/// @param idx Platform index.
+		bool paused(size_t idx) const { return pactive[idx] && !active[idx]; };
 
-				// check for new waypoint
-				if (proc || time >= convTicks(root->ways[waypoint].total)) {
-					time = 0.0f;
+		/// Updates platform activity and position from its waypoint timer.
+		/// @param idx Platform index.
+		void place(size_t idx) {
+			const uint16_t way = waypoint[idx];
+			vec3x& pos = now[idx];
 
-					// update start position
-					start = root->ways[waypoint].dest;
+			// check if waypoint exists
+			if (way != 0xffff) {
+				const Bytes::Waypoint& data = root[idx]->ways[way];
 
-					// select new waypoint
-					switch (root->ways[waypoint].after) {
-						case Bytes::Waypoint::Halt: waypoint = 0xffff; break;
-						case Bytes::Waypoint::Next: waypoint++;        break;
-						case Bytes::Waypoint::Loop: waypoint = 0;      break;
-					};
-				};
+				// update activity
+				active[idx] = time[idx] < data.time;
 
-				// check if new waypoint exists
-				if (waypoint != 0xffff) {
-					// update activity
-					active = time < convTicks(root->ways[waypoint].time);
-
-					// update position
-					if (active) {
-						fix t = (fix)(time / convTicks(root->ways[waypoint].time));
-						now = vec3x::lerp(start, root->ways[waypoint].dest, t);
-					} else
-						now = root->ways[waypoint].dest;
-				} else {
-					// no new active waypoint
-					active = false;
-					now = start;
-				};
+				// update position
+				if (active[idx])
+					pos = vec3x::lerp(start[idx], data.dest, (fix)((float)time[idx] / data.time));
+				else
+					pos = data.dest;
 			} else {
 				// no active waypoint
-				active = false;
-				now = start;
+				active[idx] = false;
+				pos = start[idx];
 			};
 
 			// clamp position
-			now = vec3x(
-				(now.x * 64fx).round() / 64fx,
-				(now.y * 64fx).round() / 64fx,
-				(now.z * 64fx).round() / 64fx
-			);
+			pos = vec3x(pos.x.round(6), pos.y.round(6), pos.z.round(6));
+		};
+
+		/// Jumps over finished waypoints.
+		/// @param idx Platform index.
+		/// @param ticks Ticks elapsed since current waypoint start.
+		/// @note Takes O(log waypoints) time regardless of elapsed tick count.
+		void seek(size_t idx, uint32_t ticks) {
+			const std::vector<Bytes::Waypoint>& ways = root[idx]->ways;
+			const Timeline& line = timelines[idx];
+			uint16_t& way = waypoint[idx];
+
+			// walk through waypoint runs
+			while (way != 0xffff) {
+				const uint16_t last = line.end[way];
+				const uint32_t offset = line.begin[way] + ticks;
+				const uint32_t stop = line.begin[last] + line.span[last];
+
+				// find waypoint inside of current run
+				if (offset < stop) {
+					uint16_t found = std::upper_bound(line.begin.begin() + way, line.begin.begin() + last + 1, offset) - line.begin.begin() - 1;
+					if (found != way) start[idx] = ways[found - 1].dest;
+					way = found;
+					time[idx] = offset - line.begin[found];
+					return;
+				};
+
+				// skip the whole run
+				ticks = offset - stop;
+				start[idx] = ways[last].dest;
+				way = Timeline::next(ways, last);
+				time[idx] = 0;
+
+				// skip full loops
+				uint32_t period = line.period(ways);
+				if (way == 0 && period != 0 && ticks >= period) {
+					ticks %= period;
+					start[idx] = ways[line.end[0]].dest;
+				};
+			};
+		};
 
-			// update model
-			if (!proc) Models::Moving::update(*object, root->theme, root->half, (float)now.z);
+		/// Advances platform waypoint state.
+		/// @param idx Platform index.
+		/// @param ticks Elapsed ticks since last update.
+		/// @note Regular updates only bump a counter, the timeline is consulted once a waypoint ends.
+		void advance(size_t idx, uint32_t ticks) {
+			const uint16_t way = waypoint[idx];
+			if (way != 0xffff) {
+				const Bytes::Waypoint& data = root[idx]->ways[way];
+				uint32_t& t = time[idx];
+
+				// update waypoint timer
+				t += ticks;
+
+				// switch waypoints through the timeline (ended waypoints last whole steps)
+				if (t >= data.total)
+					seek(idx, std::max(t, timelines[idx].span[way]));
+			};
+			place(idx);
 		};
 
-		/// Draws the moving platform.
+		/// Updates moving platform states.
+		/// @param delta Elapsed time since last frame.
+		/// @param changes Changed platform set.
+		void update(float delta, Dirty& changes) {
+			const size_t count = size();
+			const uint32_t ticks = convTime(delta);
+			for (size_t i = 0; i < count; i++) {
+				if (!idle(i)) changes.mark(i);
+				prev[i] = now[i];
+				pactive[i] = active[i];
+				advance(i, ticks);
+			};
+			refresh();
+		};
+
+		/// Updates platform models from current positions.
+		void refresh() {
+			if (objects.empty()) return;
+			for (size_t i = 0; i < size(); i++)
+				Models::Moving::update(objects[i], root[i]->theme, root[i]->half, (float)now[i].z);
+		};
+
+		/// Returns interpolated platform render position.
+		/// @param idx Platform index.
+		/// @param alpha Progress from previous to current position.
+		glm::vec3 render(size_t idx, float alpha) const { return lerpv(prev[idx].gl(), now[idx].gl(), alpha); };
+
+		/// Draws the moving platforms.
+		/// @param alpha Interpolation factor between simulation steps.
 		/// @return Drawn vertex count.
-		size_t draw() {
+		size_t draw(float alpha) {
 			size_t vertcount = 0;
-			if (object) {
-				// draw platform
-				Assets::terrain.bind();
-				object->pos = now.gl();
-				vertcount += object->draw(Shaders::tex);
-
-				// draw highlight
-				Assets::mask.bind();
-				if (active)
-					vertcount += Models::drawActive(object->pos, root->half);
+			if (objects.empty()) return 0;
+			for (size_t i = 0; i < size(); i++) {
+				Object& object = objects[i];
+
+				// queue platform
+				object.pos = render(i, alpha);
+				vertcount += RenderQueue::submit(RenderQueue::Color, RenderQueue::Solid, Shaders::tex, Assets::terrain, object);
+
+				// queue highlight
+				if (active[i])
+					vertcount += Models::drawActive(object.pos, half[i]);
 				else
-					vertcount += Models::drawInactive(object->pos, root->half);
+					vertcount += Models::drawInactive(object.pos, half[i]);
 			};
 			return vertcount;
 		};
 
 		/// Returns a moving platform volume.
-		vol3x volume() const { return Bytes::Block(root->half ? Bytes::Block::Half : Bytes::Block::Full).volume() + now; };
+		/// @param idx Platform index.
+		vol3x volume(size_t idx) const { return Bytes::Block(half[idx] ? Bytes::Block::Half : Bytes::Block::Full).volume() + now[idx]; };
 
 		/// Returns moving platform velocity.
-		vec3x velocity() const { return now - prev; };
+		/// @param idx Platform index.
+		vec3x velocity(size_t idx) const { return now[idx] - prev[idx]; };
 	};
 };
\ No newline at end of file
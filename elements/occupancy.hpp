@@ -0,0 +1,110 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	using Bytes::Block;
+
+	/// Terrain occupancy bitsets.
+	/// @note Each Z layer stores one bit row per Y coordinate for full and half blocks.
+	/// @note Rows are padded with air on every side, so clamped coordinates never hit solid blocks.
+	class Occupancy {
+		private:
+		/// Full block bits.
+		std::vector<uint64_t> full;
+		/// Half block bits.
+		std::vector<uint64_t> half;
+		/// Terrain size.
+		sf::Vector3i size;
+		/// Words per bit row.
+		int stride = 0;
+
+		/// Clamps a coordinate into padded range.
+		/// @param v Coordinate.
+		/// @param min Minimal padded coordinate.
+		/// @param max Maximal padded coordinate.
+		static int clamp(int v, int min, int max) { return std::min(std::max(v, min), max); };
+
+		/// Returns bit row offset of a block row.
+		/// @param y Row Y coordinate.
+		/// @param z Row Z coordinate.
+		size_t offset(int y, int z) const {
+			y = clamp(y, -1, size.y) + 1;
+			z = clamp(z, -1, size.z) + 1;
+			return ((size_t)z * (size.y + 2) + y) * stride;
+		};
+
+		/// Returns bit index of a block in its row.
+		/// @param x Block X coordinate.
+		/// @note First row word is padding.
+		int column(int x) const { return clamp(x, -64, size.x) + 64; };
+
+		/// Extracts bits from a row.
+		/// @param bits Row words.
+		/// @param bit First bit index.
+		static uint64_t extract(const uint64_t* bits, int bit) {
+			const uint64_t* word = bits + (bit >> 6);
+			int shift = bit & 63;
+			return word[0] >> shift | (word[1] << 1) << (63 - shift);
+		};
+
+		public:
+		/// Empty occupancy constructor.
+		Occupancy () {};
+
+		/// Builds occupancy from terrain data.
+		/// @param terrain Terrain data.
+		Occupancy (const Bytes::Terrain& terrain): size(terrain.size) {
+			stride = (size.x + 63) / 64 + 3;
+			full.assign((size_t)(size.z + 2) * (size.y + 2) * stride, 0);
+			half.assign(full.size(), 0);
+
+			// set block bits
+			for (int z = 0; z < size.z; z++) {
+				for (int y = 0; y < size.y; y++) {
+					size_t row = offset(y, z);
+					for (int x = 0; x < size.x; x++) {
+						Block::Type type = terrain.at({x, y, z}).type();
+						int bit = column(x);
+						if (type == Block::Full) full[row + (bit >> 6)] |= 1ULL << (bit & 63);
+						if (type == Block::Half) half[row + (bit >> 6)] |= 1ULL << (bit & 63);
+					};
+				};
+			};
+		};
+
+		/// Returns occupied blocks in a row.
+		/// @param pos First block position.
+		/// @param count Block count (less than 64).
+		/// @param isFull Whether to return full blocks instead of half blocks.
+		/// @return Occupancy mask, where bit N is block at X + N.
+		uint64_t row(sf::Vector3i pos, int count, bool isFull) const {
+			const uint64_t* bits = (isFull ? full : half).data() + offset(pos.y, pos.z);
+			return extract(bits, column(pos.x)) & ((1ULL << count) - 1);
+		};
+
+		/// Checks if a solid exists at the mini-position.
+		/// @param pos Mini-position.
+		/// @param type Whether to check for only full blocks.
+		/// @param mini Check region size.
+		/// @note Half blocks cover the upper half of a block, which is mini layer 1 partially and mini layer 2 fully.
+		bool solid(sf::Vector3i pos, bool type, bool mini) const {
+			// get block position with floor division
+			sf::Vector3i block = {
+				(pos.x - (pos.x < 0) * 2) / 3,
+				(pos.y - (pos.y < 0) * 2) / 3,
+				(pos.z - (pos.z < 0) * 2) / 3
+			};
+			int layer = pos.z - block.z * 3;
+
+			// fetch block bits
+			size_t row = offset(block.y, block.z);
+			int bit = column(block.x);
+			bool isFull = full[row + (bit >> 6)] >> (bit & 63) & 1;
+			bool isHalf = half[row + (bit >> 6)] >> (bit & 63) & 1;
+
+			// check half block coverage
+			bool cover = type ? (mini & (layer == 2)) : (!mini | (layer != 0));
+			return isFull | (isHalf & cover);
+		};
+	};
+};
@@ -14,17 +14,15 @@ namespace Level {
 		/// @param data Prism data.
 		Prism (const Bytes::Prism* data): root(data), dark(false) {};
 
-		/// Draws the prism.
+		/// Queues the prism for drawing.
 		/// @return Drawn vertex count.
 		size_t draw() {
-			Assets::mask.bind();
 			return Models::drawPrism(root->pos.gl(), dark);
 		};
 
-		/// Draws prism's shadow.
+		/// Queues prism's shadow for drawing.
 		/// @return Drawn vertex count.
 		size_t shadow() {
-			Assets::mask.bind();
 			return Models::drawPrismShadow(root->pos.gl(), dark);
 		};
 
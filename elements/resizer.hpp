@@ -11,13 +11,11 @@ namespace Level {
 		/// @param data Resizer data.
 		Resizer (const Bytes::Resizer* data): root(data) {};
 
-		/// Draws the resizer.
+		/// Queues the resizer for drawing.
 		/// @return Drawn vertex count.
 		size_t draw() {
-			if (root->visible) {
-				Assets::mask.bind();
+			if (root->visible)
 				return Models::drawResizer(root->pos.gl(), root->mode == Bytes::Resizer::Shrink);
-			};
 			return 0;
 		};
 	};
@@ -0,0 +1,216 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Rewind memory budget of game levels in bytes.
+	size_t rewindBudget = 16 << 20;
+
+	/// Rewind buffer of simulation snapshots.
+	/// @note Every N-th frame is stored as a keyframe, others as run-length coded differences to it.
+	/// @note Frames are written into a byte ring allocated once from the memory budget, so captures do not allocate.
+	/// @note Oldest keyframe groups are dropped once the ring runs out of space or frame slots.
+	class Rewind {
+		private:
+		/// Stored frame object.
+		struct Frame {
+			uint32_t offset; // Frame data offset in the byte ring.
+			uint32_t   size; // Frame data size.
+			bool        key; // Whether the frame is a keyframe.
+		};
+
+		/// Budget bytes per frame slot.
+		static const size_t slotBytes = 256;
+
+		/// Frame data byte ring.
+		std::vector<uint8_t> ring;
+		/// Frame slot ring.
+		std::vector<Frame> frames;
+		/// Oldest frame slot index.
+		size_t first = 0;
+		/// Stored frame count.
+		size_t count = 0;
+		/// Latest keyframe data.
+		std::vector<uint8_t> keyframe;
+		/// Encoded difference scratch buffer.
+		std::vector<uint8_t> scratch;
+		/// Keyframe interval in ticks.
+		size_t interval;
+		/// Stored frame bytes.
+		size_t usage = 0;
+		/// Frames since latest keyframe.
+		size_t since = 0;
+
+		/// Returns a stored frame.
+		/// @param idx Frame index, oldest first.
+		Frame& at(size_t idx) { return frames[(first + idx) % frames.size()]; };
+
+		/// Encodes frame difference to latest keyframe.
+		/// @param raw Frame data.
+		/// @param out Encoded difference.
+		/// @note Difference is a list of (zero count, literal count, literal bytes) runs.
+		void encode(const std::vector<uint8_t>& raw, std::vector<uint8_t>& out) const {
+			out.clear();
+			size_t n = raw.size();
+			auto diff = [&](size_t i) -> uint8_t { return raw[i] ^ keyframe[i]; };
+
+			for (size_t i = 0; i < n;) {
+				// count unchanged bytes
+				size_t lit = i;
+				while (lit + 8 <= n && lit - i < 0xfff8 && memcmp(&raw[lit], &keyframe[lit], 8) == 0) lit += 8;
+				while (lit < n && lit - i < 0xffff && diff(lit) == 0) lit++;
+
+				// count changed bytes until 4 unchanged bytes
+				size_t end = lit;
+				while (end < n && end - lit < 0xffff) {
+					size_t zeros = 0;
+					while (end + zeros < n && zeros < 4 && diff(end + zeros) == 0) zeros++;
+					if (zeros == 4 || end + zeros == n) break;
+					end += zeros + 1;
+				};
+				end = std::min(end, lit + 0xffff);
+
+				// write run
+				uint16_t head[2] = { (uint16_t)(lit - i), (uint16_t)(end - lit) };
+				out.insert(out.end(), (uint8_t*)head, (uint8_t*)(head + 2));
+				for (size_t j = lit; j < end; j++) out.push_back(diff(j));
+				i = end;
+			};
+		};
+
+		/// Decodes frame difference to a keyframe.
+		/// @param key Keyframe data.
+		/// @param delta Encoded difference.
+		/// @param out Decoded frame data.
+		void decode(const Frame& key, const Frame& delta, std::vector<uint8_t>& out) const {
+			out.assign(ring.begin() + key.offset, ring.begin() + key.offset + key.size);
+			const uint8_t* data = ring.data() + delta.offset;
+			size_t ptr = 0;
+			for (size_t i = 0; i + 4 <= delta.size;) {
+				uint16_t head[2];
+				memcpy(head, data + i, 4);
+				i += 4;
+				ptr += head[0];
+				for (uint16_t j = 0; j < head[1]; j++)
+					out[ptr++] ^= data[i++];
+			};
+		};
+
+		/// Finds ring space for a new frame.
+		/// @param size Frame data size.
+		/// @return Frame data offset, or `-1` if there is no space.
+		size_t place(size_t size) {
+			if (count == 0) return size <= ring.size() ? 0 : -1ULL;
+			const Frame& old = at(0);
+			const Frame& last = at(count - 1);
+			size_t end = last.offset + last.size;
+
+			// check space after newest frame, then before oldest frame
+			if (last.offset >= old.offset) {
+				if (ring.size() - end >= size) return end;
+				if (old.offset >= size) return 0;
+			} else if (old.offset - end >= size) return end;
+			return -1ULL;
+		};
+
+		/// Drops the oldest keyframe group.
+		/// @return Whether a group was dropped (the latest group is kept).
+		bool evict() {
+			size_t next = 1;
+			while (next < count && !at(next).key) next++;
+			if (next >= count) return false;
+
+			// drop group frames
+			for (size_t i = 0; i < next; i++)
+				usage -= at(i).size;
+			first = (first + next) % frames.size();
+			count -= next;
+			return true;
+		};
+
+		public:
+		/// Rewind buffer constructor.
+		/// @param budget Memory budget in bytes (0 disables capturing).
+		/// @param interval Keyframe interval in ticks.
+		/// @note Frame slots take a part of the budget, one per `slotBytes` bytes.
+		Rewind (size_t budget = 0, size_t interval = 60): interval(std::max<size_t>(interval, 1)) {
+			size_t slots = budget / slotBytes;
+			frames.resize(slots);
+			ring.resize(slots ? budget - slots * sizeof(Frame) : 0);
+		};
+
+		/// Checks whether capturing is enabled.
+		bool enabled() const { return !frames.empty(); };
+
+		/// Returns stored frame count.
+		size_t size() const { return count; };
+
+		/// Returns stored frame bytes.
+		size_t bytes() const { return usage; };
+
+		/// Drops all frames.
+		void clear() {
+			first = 0;
+			count = 0;
+			usage = 0;
+			since = 0;
+		};
+
+		/// Stores a new frame.
+		/// @param raw Frame data.
+		/// @note Frames larger than the byte ring are not stored.
+		void push(const std::vector<uint8_t>& raw) {
+			if (!enabled()) return;
+			bool key = count == 0 || since + 1 >= interval || raw.size() != keyframe.size();
+			if (!key) encode(raw, scratch);
+
+			// make space for the frame
+			size_t offset;
+			while (count == frames.size() || (offset = place(key ? raw.size() : scratch.size())) == -1ULL) {
+				if (evict()) continue;
+
+				// restart from a keyframe if the latest group fills the ring
+				if (count == 0) return;
+				clear();
+				key = true;
+			};
+
+			// store frame data
+			const std::vector<uint8_t>& data = key ? raw : scratch;
+			if (!data.empty()) memcpy(ring.data() + offset, data.data(), data.size());
+			if (key) {
+				keyframe.assign(raw.begin(), raw.end());
+				since = 0;
+			} else since++;
+
+			// add frame
+			at(count++) = { (uint32_t)offset, (uint32_t)data.size(), key };
+			usage += data.size();
+		};
+
+		/// Seeks back a number of frames.
+		/// @param ticks Frame count before latest frame.
+		/// @param raw Restored frame data.
+		/// @return Actual frame count sought back.
+		/// @note Newer frames are dropped, and the next frame becomes a keyframe.
+		size_t seek(size_t ticks, std::vector<uint8_t>& raw) {
+			if (count == 0) return 0;
+			ticks = std::min(ticks, count - 1);
+			size_t idx = count - 1 - ticks;
+
+			// decode frame
+			size_t key = idx;
+			while (!at(key).key) key--;
+			const Frame& frame = at(idx);
+			if (key == idx)
+				raw.assign(ring.begin() + frame.offset, ring.begin() + frame.offset + frame.size);
+			else
+				decode(at(key), frame, raw);
+
+			// drop newer frames
+			while (count > idx + 1)
+				usage -= at(--count).size;
+			since = interval;
+			return ticks;
+		};
+	};
+};
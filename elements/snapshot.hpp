@@ -0,0 +1,100 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Simulation state serializer.
+	/// @note The same field visit is used for measuring, saving, loading and hashing.
+	class Snapshot {
+		public:
+		/// Serializer mode enumeration.
+		enum Mode {
+			Measure, // Only count bytes.
+			Save   , // Write fields into buffer.
+			Load   , // Read fields from buffer.
+			Hash   , // Hash field values.
+		};
+
+		private:
+		/// Snapshot data buffer.
+		std::vector<uint8_t>* data;
+		/// Current buffer offset.
+		size_t ptr = 0;
+		/// Serializer mode.
+		Mode mode;
+		/// Running state hash.
+		uint64_t digest = 0x84222325CBF29CE4ULL;
+
+		/// Mixes a field into the state hash.
+		/// @param value Field data.
+		/// @param size Field size.
+		void mix(const void* value, size_t size) {
+			const uint8_t* bytes = (const uint8_t*)value;
+			for (size_t i = 0; i < size; i += 8) {
+				uint64_t word = 0;
+				memcpy(&word, bytes + i, std::min<size_t>(8, size - i));
+				digest ^= word * 0x9E3779B97F4A7C15ULL;
+				digest = (digest << 31 | digest >> 33) * 0xBF58476D1CE4E5B9ULL;
+			};
+		};
+
+		public:
+		/// Serializer constructor.
+		/// @param mode Serializer mode.
+		/// @param data Snapshot data buffer.
+		/// @note Saving will overwrite the buffer, call `finish()` afterwards.
+		Snapshot (Mode mode, std::vector<uint8_t>* data = NULL): data(data), mode(mode) {};
+
+		/// Trims saved buffer to visited size.
+		void finish() { if (mode == Save) data->resize(ptr); };
+
+		/// Checks whether the serializer reads fields.
+		bool loading() const { return mode == Load; };
+
+		/// Returns visited byte count.
+		size_t size() const { return ptr; };
+
+		/// Returns the state hash.
+		uint64_t hash() const {
+			uint64_t h = digest ^ ptr;
+			h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+			return h ^ (h >> 31);
+		};
+
+		/// Visits a field.
+		/// @param value Field reference.
+		/// @note Pointers are not hashed, as they differ between runs.
+		/// @return Self-reference.
+		template <typename T> Snapshot& operator()(T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "snapshot fields must be trivially copyable");
+			switch (mode) {
+				case Save:
+					if (data->size() < ptr + sizeof(T)) data->resize(ptr + sizeof(T));
+					memcpy(data->data() + ptr, &value, sizeof(T));
+					break;
+				case Load:
+					memcpy(&value, data->data() + ptr, sizeof(T));
+					break;
+				case Hash:
+					if (!std::is_pointer<T>::value) mix(&value, sizeof(T));
+					break;
+				default: break;
+			};
+			ptr += sizeof(T);
+			return *this;
+		};
+
+		/// Skips padding bytes.
+		/// @param size Padding size.
+		/// @note Saving writes zeros, so unused slots encode identically.
+		/// @return Self-reference.
+		Snapshot& skip(size_t size) {
+			if (mode == Save) {
+				if (data->size() < ptr + size) data->resize(ptr + size);
+				memset(data->data() + ptr, 0, size);
+			};
+			ptr += size;
+			return *this;
+		};
+	};
+};
@@ -6,10 +6,40 @@ namespace Level {
 	using Bytes::Block;
 
 	/// Terrain object.
+	/// @note Terrain model is split into fixed-size chunks, which are culled and rebuilt separately.
 	class Terrain {
+		public:
+		static const int chunkX = 16; // Chunk width.
+		static const int chunkY = 16; // Chunk length.
+		static const int chunkZ =  8; // Chunk height.
+		static_assert(std::max({ chunkX, chunkY, chunkZ }) <= Models::Terrain::maxRepeats, "Chunk size exceeds terrain quad repeat limit");
+
 		private:
-		/// Terrain model.
-		Object* object = NULL;
+		/// Terrain model chunk.
+		struct Chunk {
+			Object* object; // Chunk model (`NULL` if empty).
+			glm::vec3  min; // Model bounding box minimum.
+			glm::vec3  max; // Model bounding box maximum.
+			size_t   faces; // Visible block face count.
+			size_t   quads; // Merged quad count.
+		};
+
+		/// Visible block face.
+		struct Face {
+			GLint tile =    -1; // Face tile index (-1 if face is hidden).
+			bool half = false; // Whether the face belongs to a half block.
+
+			/// Checks whether faces can be merged.
+			/// @param face Other face.
+			bool operator==(const Face& face) const { return tile == face.tile; };
+		};
+
+		/// Terrain model chunks.
+		std::vector<Chunk> chunks;
+		/// Chunk grid size.
+		sf::Vector3i grid;
+		/// Level exit position.
+		sf::Vector3i exit;
 
 		/// Checks if a side should be drawn.
 		/// @param Block with tested face.
@@ -41,17 +71,19 @@ namespace Level {
 		public:
 		/// Terrain data.
 		Bytes::Terrain root;
+		/// Terrain occupancy.
+		Occupancy bits;
 
 		/// Structure constructor.
 		/// @param data Terrain data.
-		Terrain (Bytes::Terrain data = {}): root(data) {};
+		Terrain (Bytes::Terrain data = {}): root(data), bits(root) {};
 		/// Copy constructor.
 		/// @param terrain Copied terrain object.
 		Terrain (const Terrain& terrain) = delete;
 		/// Move constructor.
 		/// @param terrain Moved terrain object.
-		Terrain (Terrain&& terrain): object(terrain.object), root(terrain.root) {
-			terrain.object = NULL;
+		Terrain (Terrain&& terrain): chunks(std::move(terrain.chunks)), grid(terrain.grid), exit(terrain.exit), root(terrain.root), bits(std::move(terrain.bits)) {
+			terrain.chunks.clear();
 		};
 		/// Copy assignment.
 		/// @param terrain Copied terrain object.
@@ -59,72 +91,251 @@ namespace Level {
 		/// Move assignment.
 		/// @param terrain Moved terrain object.
 		Terrain& operator=(Terrain&& terrain) {
-			this->~Terrain();
-			object = terrain.object; terrain.object = NULL;
-			root = terrain.root; terrain.root = {};
+			clear();
+			chunks = std::move(terrain.chunks); terrain.chunks.clear();
+			grid = terrain.grid;
+			exit = terrain.exit;
+			root = std::move(terrain.root);
+			bits = std::move(terrain.bits);
 			return *this;
 		};
 		/// Terrain destructor.
-		~Terrain () { delete object; };
+		~Terrain () { clear(); };
 
-		/// Renders terrain.
+		/// Deletes terrain model.
+		void clear() {
+			for (Chunk& chunk : chunks) delete chunk.object;
+			chunks.clear();
+		};
+
+		/// Queues visible terrain chunks for drawing.
+		/// @param view Camera view frustum.
 		/// @return Drawn vertex count.
-		size_t draw() {
-			if (object) {
-				Assets::terrain.bind();
-				return object->draw(Shaders::tex);
+		size_t draw(const Frustum& view) const {
+			size_t vertcount = 0;
+			for (const Chunk& chunk : chunks) {
+				if (chunk.object && view.visible(chunk.min, chunk.max))
+					vertcount += RenderQueue::submit(RenderQueue::Color, RenderQueue::Solid, Shaders::ter, Assets::terrain, *chunk.object);
 			};
-			return 0;
+			return vertcount;
+		};
+
+		/// Returns visible block face count.
+		size_t faces() const {
+			size_t count = 0;
+			for (const Chunk& chunk : chunks) count += chunk.faces;
+			return count;
+		};
+
+		/// Returns merged terrain quad count.
+		size_t quads() const {
+			size_t count = 0;
+			for (const Chunk& chunk : chunks) count += chunk.quads;
+			return count;
 		};
 
 		/// Generates terrain model.
 		/// @param level Level data.
 		void model(const Bytes::Level* level) {
-			// generate model buffer
-			object = new Object;
+			clear();
 
 			// fetch exit position
-			sf::Vector3i exit = level->exit.int3();
+			exit = level->exit.int3();
 
-			// generate vertices
-			std::vector<Vertex> verts;
-			for (int z = 0; z < root.size.z; z++) {
-				for (int y = 0; y < root.size.y; y++) {
-					for (int x = 0; x < root.size.x; x++) {
+			// generate chunks
+			grid = {
+				(root.size.x + chunkX - 1) / chunkX,
+				(root.size.y + chunkY - 1) / chunkY,
+				(root.size.z + chunkZ - 1) / chunkZ
+			};
+			chunks.resize(grid.x * grid.y * grid.z, { NULL, glm::vec3(0.0f), glm::vec3(0.0f), 0, 0 });
+			for (size_t i = 0; i < chunks.size(); i++)
+				build(i);
+		};
+
+		/// Rebuilds terrain model around a changed block.
+		/// @param pos Block position.
+		/// @note Neighbor chunks are rebuilt as well if the block lies on their border.
+		void rebuild(sf::Vector3i pos) {
+			if (chunks.empty()) return;
+			sf::Vector3i min = chunkOf(pos - sf::Vector3i(1, 1, 1));
+			sf::Vector3i max = chunkOf(pos + sf::Vector3i(1, 1, 1));
+			for (int z = min.z; z <= max.z; z++) {
+				for (int y = min.y; y <= max.y; y++) {
+					for (int x = min.x; x <= max.x; x++)
+						build((z * grid.y + y) * grid.x + x);
+				};
+			};
+		};
+
+		private:
+		/// Returns chunk containing a block.
+		/// @param pos Block position.
+		/// @note Result is clamped to chunk grid.
+		sf::Vector3i chunkOf(sf::Vector3i pos) const {
+			return {
+				std::min(std::max(pos.x, 0), root.size.x - 1) / chunkX,
+				std::min(std::max(pos.y, 0), root.size.y - 1) / chunkY,
+				std::min(std::max(pos.z, 0), root.size.z - 1) / chunkZ
+			};
+		};
+
+		/// Merges visible faces of one direction into quads.
+		/// @param verts Output vertices.
+		/// @param cells Chunk block faces.
+		/// @param dir Face direction.
+		/// @param min Chunk minimum block position.
+		/// @param dim Chunk dimensions.
+		/// @note Faces are grown along the first plane axis, then the second one.
+		/// @note Half block sides never merge vertically, since stacked half blocks leave gaps.
+		void merge(std::vector<Vertex>& verts, std::vector<Face>& cells, GLuint dir, sf::Vector3i min, sf::Vector3i dim) const {
+			// face plane axes in block coordinates
+			static const int normals[6] { 0, 0, 1, 1, 2, 2 };
+			int n = normals[dir];
+			int u = n == 0 ? 1 : 0;
+			int v = n == 2 ? 1 : 2;
+
+			// iterate over face planes
+			int size[3] { dim.x, dim.y, dim.z };
+			auto at = [&](int* p) -> Face& { return cells[((p[2] * dim.y + p[1]) * dim.x + p[0]) * 6 + dir]; };
+			int p[3];
+			for (p[n] = 0; p[n] < size[n]; p[n]++) {
+				for (p[v] = 0; p[v] < size[v]; p[v]++) {
+					for (p[u] = 0; p[u] < size[u]; p[u]++) {
+						Face face = at(p);
+						if (face.tile < 0) continue;
+
+						// grow along first axis
+						int q[3] { p[0], p[1], p[2] };
+						int w = 1;
+						for (q[u] = p[u] + 1; q[u] < size[u] && at(q) == face; q[u]++) w++;
+
+						// grow along second axis
+						int h = 1;
+						if (!(v == 2 && face.half)) {
+							for (q[v] = p[v] + 1; q[v] < size[v]; q[v]++, h++) {
+								bool row = true;
+								for (q[u] = p[u]; q[u] < p[u] + w && row; q[u]++)
+									row = at(q) == face;
+								if (!row) break;
+							};
+						};
+
+						// clear merged faces
+						for (q[v] = p[v]; q[v] < p[v] + h; q[v]++) {
+							for (q[u] = p[u]; q[u] < p[u] + w; q[u]++)
+								at(q).tile = -1;
+						};
+
+						// covered block range
+						int lo[3] { min.x + p[0], min.y + p[1], min.z + p[2] };
+						int hi[3] { lo[0], lo[1], lo[2] };
+						hi[u] += w - 1;
+						hi[v] += h - 1;
+
+						// checker pattern of first block
+						GLint pattern = dir == 5 ? (lo[0] ^ lo[1] ^ lo[2]) & 1 : -1;
+
+						// generate quad
+						int reps[3] { 1, 1, 1 };
+						reps[u] = w;
+						reps[v] = h;
+						Models::Terrain::quad(verts, dir,
+							glm::vec3(lo[0] - 0.5f, face.half ? lo[2] : lo[2] - 0.5f, lo[1] - 0.5f),
+							glm::vec3(hi[0] + 0.5f, hi[2] + 0.5f, hi[1] + 0.5f),
+							face.tile, pattern, glm::vec3(reps[0], reps[2], reps[1])
+						);
+					};
+				};
+			};
+		};
+
+		/// Generates terrain chunk model.
+		/// @param idx Chunk index.
+		void build(size_t idx) {
+			Chunk& chunk = chunks[idx];
+
+			// chunk block range
+			sf::Vector3i min = {
+				(int)(idx % grid.x) * chunkX,
+				(int)(idx / grid.x % grid.y) * chunkY,
+				(int)(idx / grid.x / grid.y) * chunkZ
+			};
+			sf::Vector3i max = {
+				std::min(min.x + chunkX, root.size.x),
+				std::min(min.y + chunkY, root.size.y),
+				std::min(min.z + chunkZ, root.size.z)
+			};
+			sf::Vector3i dim = max - min;
+
+			// collect visible block faces
+			// faces are stored per face direction in `Models::faces` order
+			std::vector<Face> cells(dim.x * dim.y * dim.z * 6);
+			chunk.faces = 0;
+			for (int z = min.z; z < max.z; z++) {
+				for (int y = min.y; y < max.y; y++) {
+					for (int x = min.x; x < max.x; x++) {
 						// fetch block
 						Block block = root.at({x, y, z});
 
 						// ignore air
 						if (block.type() == Block::None) continue;
 
-						// generate rendering settings
-						Models::Terrain::Settings settings;
-						settings.half = block.type() == Block::Half;
-						settings.pattern = (x ^ y ^ z) & 1;
-						settings.shade = Textures::Terrain::shadeZ(z);
-						settings.theme = block.theme();
+						// block rendering settings
+						bool half = block.type() == Block::Half;
+						uint8_t shade = Textures::Terrain::shadeZ(z);
+						Face* face = &cells[(((z - min.z) * dim.y + (y - min.y)) * dim.x + (x - min.x)) * 6];
+						auto set = [&](GLuint dir, bool draw, Models::Terrain::Slot slot, bool sized) {
+							if (!draw) return;
+							face[dir] = { Models::Terrain::tile(block.theme(), shade, slot, sized && half), half };
+							chunk.faces++;
+						};
 
 						// side faces check
-						settings.sides.xn = sideDraw(block, root.at({x - 1, y, z}));
-						settings.sides.xp = sideDraw(block, root.at({x + 1, y, z}));
-						settings.sides.zn = sideDraw(block, root.at({x, y - 1, z}));
-						settings.sides.zp = sideDraw(block, root.at({x, y + 1, z}));
+						set(0, sideDraw(block, root.at({x - 1, y, z})), Models::Terrain::ColumnX, true);
+						set(1, sideDraw(block, root.at({x + 1, y, z})), Models::Terrain::ColumnX, true);
+						set(2, sideDraw(block, root.at({x, y - 1, z})), Models::Terrain::ColumnZ, true);
+						set(3, sideDraw(block, root.at({x, y + 1, z})), Models::Terrain::ColumnZ, true);
 
 						// top & bottom face check
 						bool exp = udiff(x, exit.x) <= 1 && udiff(y, exit.y) <= 1;
-						settings.sides.yp = topDraw(block, root.at({x, y, z + 1})) && !(z == exit.z - 1 && exp);
-						settings.sides.yn = bottomDraw(block, root.at({x, y, z - 1})) && !(z == exit.z && exp);
-
-						// render block
-						Models::Terrain::generate(verts, glm::vec3(x, z, y), settings);
+						set(4, bottomDraw(block, root.at({x, y, z - 1})) && !(z == exit.z && exp), Models::Terrain::Floor, true);
+						set(5, topDraw(block, root.at({x, y, z + 1})) && !(z == exit.z - 1 && exp), Models::Terrain::Surface, false);
 					};
 				};
 			};
 
+			// merge faces into quads
+			std::vector<Vertex> verts;
+			for (GLuint dir = 0; dir < 6; dir++)
+				merge(verts, cells, dir, min, dim);
+			chunk.quads = verts.size() / 4;
+
+			// drop empty chunks
+			if (verts.empty()) {
+				delete chunk.object;
+				chunk.object = NULL;
+				return;
+			};
+
+			// calculate bounding box
+			chunk.min = chunk.max = verts[0].pos;
+			for (const Vertex& vert : verts) {
+				chunk.min = glm::min(chunk.min, vert.pos);
+				chunk.max = glm::max(chunk.max, vert.pos);
+			};
+
+			// move vertices relative to chunk origin
+			// packed vertices only cover a limited range around model origin
+			for (Vertex& vert : verts)
+				vert.pos -= chunk.min;
+
 			// update model geometry
-			object->set(verts);
-			object->indexQuads();
-			object->update();
+			if (chunk.object == NULL)
+				chunk.object = new Object(GL_TRIANGLES, true);
+			chunk.object->pos = chunk.min;
+			chunk.object->set(verts);
+			chunk.object->indexQuads();
 		};
 	};
 };
\ No newline at end of file
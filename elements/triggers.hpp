@@ -0,0 +1,146 @@
+#pragma once
+
+/// Level related namespace.
+namespace Level {
+	/// Cube interaction trigger spatial index.
+	/// @note Triggers are bucketed into unit grid cells containing the cube positions they react to.
+	/// @note Cell lists keep element indices in ascending order, so triggers fire in level order.
+	/// @note Callers still perform exact trigger checks, since a cell only narrows down candidates.
+	class Triggers {
+		public:
+		/// Trigger lists of a grid cell.
+		struct Cell {
+			std::vector<uint16_t>   bumpers; // Bumper indices.
+			std::vector<uint16_t>  triggers; // Camera trigger indices.
+			std::vector<uint16_t> darkcubes; // Dark cube spawner indices.
+			std::vector<uint16_t>    checks; // Checkpoint indices.
+			std::vector<uint16_t>   buttons; // Button indices.
+			std::vector<uint16_t>     ports; // Teleporter indices.
+			std::vector<uint16_t>  fallings; // Falling platform indices.
+			std::vector<uint16_t>  resizers; // Resizer indices.
+		};
+
+		private:
+		/// Cell list type.
+		typedef std::vector<uint16_t> Cell::*List;
+		/// Grid cell range type.
+		typedef Broadphase::Range Range;
+
+		/// Attached button entry.
+		struct Attached {
+			uint16_t button; // Button index.
+			Range     range; // Covered cell range.
+		};
+
+		/// Trigger lists of each occupied grid cell.
+		std::unordered_map<uint64_t, Cell> cells;
+		/// Buttons attached to moving platforms.
+		std::vector<Attached> attached;
+		/// Cell without any triggers.
+		Cell none;
+
+		/// Returns grid cells containing positions inside of a field.
+		/// @param mid Field middle position.
+		/// @param rad Field radius.
+		static Range range(vec3x mid, vec2x rad) {
+			return {
+				{ (int)(mid.x - rad.x), (int)(mid.y - rad.y), (int)mid.z },
+				{ (int)(mid.x + rad.x), (int)(mid.y + rad.y), (int)mid.z }
+			};
+		};
+
+		/// Returns a grid cell containing a position.
+		/// @param pos Trigger position.
+		static Range range(vec3x pos) { return { pos.int3(), pos.int3() }; };
+
+		/// Inserts a trigger into grid cells.
+		/// @param list Cell list.
+		/// @param idx Element index.
+		/// @param r Covered cell range.
+		void insert(List list, uint16_t idx, const Range& r) {
+			for (int y = r.min.y; y <= r.max.y; y++) {
+				for (int x = r.min.x; x <= r.max.x; x++) {
+					std::vector<uint16_t>& ids = cells[Broadphase::key(x, y, r.min.z)].*list;
+					ids.insert(std::upper_bound(ids.begin(), ids.end(), idx), idx);
+				};
+			};
+		};
+
+		/// Removes a trigger from grid cells.
+		/// @param list Cell list.
+		/// @param idx Element index.
+		/// @param r Covered cell range.
+		/// @note Emptied cells are kept, since attached triggers tend to come back.
+		void erase(List list, uint16_t idx, const Range& r) {
+			for (int y = r.min.y; y <= r.max.y; y++) {
+				for (int x = r.min.x; x <= r.max.x; x++) {
+					auto it = cells.find(Broadphase::key(x, y, r.min.z));
+					if (it == cells.end()) continue;
+
+					// remove trigger from cell list
+					std::vector<uint16_t>& ids = it->second.*list;
+					ids.erase(std::lower_bound(ids.begin(), ids.end(), idx));
+				};
+			};
+		};
+
+		public:
+		/// Rebuilds the index from scratch.
+		/// @param root Level data.
+		/// @param plats Moving platform list.
+		void build(const Bytes::Level& root, const MovingPlats& plats) {
+			cells.clear();
+			attached.clear();
+
+			// static triggers
+			for (size_t i = 0; i < root.bumpers.size(); i++)
+				insert(&Cell::bumpers, i, range(root.bumpers[i].pos + vec3x::fromDir(root.bumpers[i].dir)));
+			for (size_t i = 0; i < root.triggers.size(); i++)
+				insert(&Cell::triggers, i, range(root.triggers[i].pos, root.triggers[i].rad));
+			for (size_t i = 0; i < root.darkcubes.size(); i++)
+				insert(&Cell::darkcubes, i, range(root.darkcubes[i].pos, root.darkcubes[i].rad));
+			for (size_t i = 0; i < root.checks.size(); i++)
+				insert(&Cell::checks, i, range(root.checks[i].pos, root.checks[i].rad));
+			for (size_t i = 0; i < root.ports.size(); i++)
+				insert(&Cell::ports, i, range(root.ports[i].pos, root.ports[i].rad));
+			for (size_t i = 0; i < root.resizers.size(); i++)
+				insert(&Cell::resizers, i, range(root.resizers[i].pos, root.resizers[i].rad));
+
+			// falling platforms only react while solid, so they never leave their initial cell
+			for (size_t i = 0; i < root.fallings.size(); i++)
+				insert(&Cell::fallings, i, range(root.fallings[i].pos + vec3x(0, 0, 1)));
+
+			// buttons
+			for (size_t i = 0; i < root.buttons.size(); i++) {
+				const Bytes::Button& button = root.buttons[i];
+				if (button.attached) {
+					attached.push_back({ (uint16_t)i, range(plats.now[button.moving] + vec3x(0, 0, 1), button.rad) });
+					insert(&Cell::buttons, i, attached.back().range);
+				} else {
+					insert(&Cell::buttons, i, range(button.pos, button.rad));
+				};
+			};
+		};
+
+		/// Moves attached triggers that changed grid cells.
+		/// @param root Level data.
+		/// @param plats Moving platform list.
+		void update(const Bytes::Level& root, const MovingPlats& plats) {
+			for (Attached& entry : attached) {
+				const Bytes::Button& button = root.buttons[entry.button];
+				Range r = range(plats.now[button.moving] + vec3x(0, 0, 1), button.rad);
+				if (r == entry.range) continue;
+				erase(&Cell::buttons, entry.button, entry.range);
+				insert(&Cell::buttons, entry.button, r);
+				entry.range = r;
+			};
+		};
+
+		/// Returns triggers that may react to a cube.
+		/// @param grid Cube grid position.
+		const Cell& at(vec3x grid) const {
+			auto it = cells.find(Broadphase::key((int)grid.x, (int)grid.y, (int)grid.z));
+			return it == cells.end() ? none : it->second;
+		};
+	};
+};
\ No newline at end of file
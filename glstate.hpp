@@ -0,0 +1,133 @@
+#pragma once
+
+/// OpenGL state cache.
+/// @note All binds and capability toggles should pass through here, so redundant calls are skipped.
+/// @note Cached values may be stale after context recreation, so `reset` must be called afterwards.
+namespace GLState {
+	/// Texture unit count tracked by the cache.
+	const GLuint units = 4;
+
+	/// Tracked capability enumeration.
+	enum Cap: uint8_t {
+		Depth  , // Depth testing.
+		Stencil, // Stencil testing.
+		Blend  , // Alpha blending.
+		Cull   , // Face culling.
+		CapCount
+	};
+
+	size_t  issued = 0; // State calls issued since last counter reset.
+	size_t skipped = 0; // State calls skipped since last counter reset.
+
+	GLuint         program; // Used shader program.
+	GLuint             vao; // Bound vertex layout.
+	GLuint           array; // Bound vertex buffer.
+	GLuint          active; // Active texture unit.
+	GLuint textures[units]; // Bound textures per unit.
+	int8_t  caps[CapCount]; // Capability states (-1 if unknown).
+	int8_t       depthMask; // Depth write mask (-1 if unknown).
+	int8_t       colorMask; // Color write mask (-1 if unknown).
+
+	/// Counts a state call.
+	/// @param changed Whether cached state differs from the requested one.
+	/// @return Whether the call should be issued.
+	inline bool count(bool changed) {
+		if (changed) issued++;
+		else skipped++;
+		return changed;
+	};
+
+	/// Forgets all cached state.
+	void reset() {
+		program = -1;
+		vao = -1;
+		array = -1;
+		active = -1;
+		for (GLuint i = 0; i < units; i++) textures[i] = -1;
+		for (int i = 0; i < CapCount; i++) caps[i] = -1;
+		depthMask = -1;
+		colorMask = -1;
+	};
+
+	/// Resets call counters.
+	void clearCounters() {
+		issued = 0;
+		skipped = 0;
+	};
+
+	/// Uses a shader program.
+	/// @param ID Program ID.
+	void useProgram(GLuint ID) {
+		if (count(program != ID))
+			glUseProgram(program = ID);
+	};
+
+	/// Binds a vertex layout.
+	/// @param ID Vertex array ID.
+	void bindLayout(GLuint ID) {
+		if (count(vao != ID))
+			glBindVertexArray(vao = ID);
+	};
+
+	/// Binds a vertex buffer.
+	/// @param ID Array buffer ID.
+	void bindBuffer(GLuint ID) {
+		if (count(array != ID))
+			glBindBuffer(GL_ARRAY_BUFFER, array = ID);
+	};
+
+	/// Binds a texture to a texture unit.
+	/// @param unit Texture unit index.
+	/// @param ID Texture ID.
+	void bindTexture(GLuint unit, GLuint ID) {
+		if (count(textures[unit] != ID)) {
+			if (active != unit)
+				glActiveTexture(GL_TEXTURE0 + (active = unit));
+			glBindTexture(GL_TEXTURE_2D, textures[unit] = ID);
+		};
+	};
+
+	/// Enables or disables a capability.
+	/// @param cap Capability type.
+	/// @param on Whether to enable the capability.
+	void toggle(Cap cap, bool on) {
+		static const GLenum names[CapCount] { GL_DEPTH_TEST, GL_STENCIL_TEST, GL_BLEND, GL_CULL_FACE };
+		if (!count(caps[cap] != on)) return;
+		caps[cap] = on;
+		if (on) glEnable(names[cap]);
+		else glDisable(names[cap]);
+	};
+
+	/// Sets depth write mask.
+	/// @param on Whether depth writing is enabled.
+	void depthWrite(bool on) {
+		if (count(depthMask != on))
+			glDepthMask(depthMask = on);
+	};
+
+	/// Sets color write mask.
+	/// @param on Whether color writing is enabled.
+	void colorWrite(bool on) {
+		if (count(colorMask != on))
+			glColorMask(colorMask = on, on, on, on);
+	};
+
+	/// Forgets a deleted program.
+	/// @param ID Program ID.
+	void dropProgram(GLuint ID) { if (program == ID) program = -1; };
+
+	/// Forgets a deleted vertex layout.
+	/// @param ID Vertex array ID.
+	void dropLayout(GLuint ID) { if (vao == ID) vao = -1; };
+
+	/// Forgets a deleted vertex buffer.
+	/// @param ID Array buffer ID.
+	void dropBuffer(GLuint ID) { if (array == ID) array = -1; };
+
+	/// Forgets a deleted texture.
+	/// @param ID Texture ID.
+	void dropTexture(GLuint ID) {
+		for (GLuint i = 0; i < units; i++)
+			if (textures[i] == ID) textures[i] = -1;
+	};
+};
\ No newline at end of file
@@ -0,0 +1,424 @@
+#define _USE_MATH_DEFINES
+#define lengthof(x) (sizeof(x) / sizeof(x[0]))
+
+// build without window, rendering & audio
+#define HEADLESS
+
+// include SFML & OpenGL
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <GL/glew.h>
+
+// define 3d unsigned int vector
+namespace sf { typedef Vector3<unsigned int> Vector3u; };
+
+// include math libaries
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/rotate_vector.hpp>
+#include <glm/gtx/vector_angle.hpp>
+
+// include stdlib
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <math.h>
+
+// include STL
+#include <vector>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <algorithm>
+
+// include project
+#include "types.hpp"
+#include "files/file.hpp"
+#include "logging.hpp"
+#include "glstate.hpp"
+#include "shaders.hpp"
+#include "texture.hpp"
+#include "assets.hpp"
+#include "sound.hpp"
+#include "music.hpp"
+#include "timers.hpp"
+#include "vertex.hpp"
+#include "object.hpp"
+#include "queue.hpp"
+#include "render.hpp"
+#include "window.hpp"
+#include "camera.hpp"
+#include "bytes/level.hpp"
+#include "bytes/world.hpp"
+#include "elements/level.hpp"
+#include "headless.hpp"
+#include "solver.hpp"
+
+/// Prints command line usage.
+void usage() {
+	fprintf(stderr,
+		"Usage: headless <level> [options]\n"
+		"  -i <file>   Replay recorded input (\"-\" for stdin).\n"
+		"  -r <route>  Walk a world map route from <levels/routes.dat>.\n"
+		"  -t <ticks>  Tick limit (default: 36000).\n"
+		"  -l          Write level logs to <logs.txt>.\n"
+		"  -w <KiB>    Capture rewind frames within a memory budget.\n"
+		"  -h <file>   Write state hash of each tick.\n"
+		"  -d <file>   Report first tick diverging from a hash trace.\n"
+		"       headless -p [jobs] [-n threads] [-t ticks]\n"
+		"  -p [jobs]   Replay a job list (\"<level> [input]\" lines) in parallel,\n"
+		"              or every route from <levels/routes.dat> if no list is given.\n"
+		"  -n <count>  Worker thread count (default: hardware threads).\n"
+		"       headless -s <level> [-n threads] [-m count] [-o file]\n"
+		"  -s <level>  Search fastest exit path and reachable prisms.\n"
+		"  -m <count>  Maximum simulated decision count (default: 100000).\n"
+		"  -o <file>   Write fastest exit path (default: stdout).\n"
+		"       headless -b\n"
+		"  -b          Benchmark moving platform broadphase.\n"
+		"       headless -k\n"
+		"  -k          Benchmark element list update kernels.\n"
+	);
+};
+
+/// Loads route data.
+/// @param routes Loaded route data.
+/// @return Whether the data was loaded.
+bool loadRoutes(Bytes::Routes& routes) {
+	int status = 0;
+	FileReader file = FileReader::open("levels/routes.dat", &status);
+	if (status) {
+		fprintf(stderr, "Could not open <levels/routes.dat>: %s\n", strerror(status));
+		return false;
+	};
+	try {
+		routes.read(file);
+	} catch (EOFError err) {
+		fprintf(stderr, "Route data is corrupted.\n");
+		return false;
+	};
+	return true;
+};
+
+/// Loads level data.
+/// @param world Level collection.
+/// @param name Level name.
+/// @return Level data, or NULL on failure.
+const Bytes::Level* loadLevel(Data::World& world, const char* name) {
+	const Bytes::Level& data = world.load(name);
+	if (world.error) {
+		fprintf(stderr, "Could not open <levels/%s.dat>: %s\n", name, strerror(world.error));
+		return NULL;
+	};
+	if (world.bad) {
+		fprintf(stderr, "Level <%s> is corrupted.\n", name);
+		return NULL;
+	};
+	return &data;
+};
+
+/// Parallel batch replay entry.
+/// @return Exit code.
+int batch(int argcount, const char** args) {
+	const char* list = NULL;
+	size_t threads = std::thread::hardware_concurrency();
+	size_t limit = 36000;
+
+	// parse command line arguments
+	for (int i = 2; i < argcount; i++) {
+		if (strcmp(args[i], "-n") == 0 && i + 1 < argcount)
+			threads = strtoull(args[++i], NULL, 10);
+		else if (strcmp(args[i], "-t") == 0 && i + 1 < argcount)
+			limit = strtoull(args[++i], NULL, 10);
+		else if (args[i][0] != '-' && list == NULL)
+			list = args[i];
+		else {
+			usage();
+			return 1;
+		};
+	};
+
+	// load route data
+	Bytes::Routes routes;
+	if (!loadRoutes(routes)) return 0xbad;
+	Data::World world(routes);
+
+	// create job list
+	std::vector<Headless::Job> jobs;
+	if (list == NULL) {
+		for (size_t i = 0; i < routes.routes.size(); i++)
+			jobs.push_back({ "world", (long)i, routes.routes[i].file });
+	} else {
+		FILE* file = fopen(list, "r");
+		if (file == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", list, strerror(errno));
+			return 0xbad;
+		};
+		char line[512], name[256], input[256];
+		while (fgets(line, sizeof(line), file)) {
+			int count = sscanf(line, "%255s %255s", name, input);
+			if (count < 1 || name[0] == '#') continue;
+			jobs.push_back({ name, -1, count > 1 ? input : "" });
+		};
+		fclose(file);
+	};
+
+	// load job data
+	for (Headless::Job& job : jobs) {
+		job.data = loadLevel(world, job.name.c_str());
+		if (job.data == NULL) return 0xbad;
+		if (job.route >= 0 || job.file.empty()) continue;
+		FILE* file = fopen(job.file.c_str(), "r");
+		if (file == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", job.file.c_str(), strerror(errno));
+			return 0xbad;
+		};
+		job.input = Bytes::Path().parse(file);
+		fclose(file);
+	};
+
+	// run simulations
+	sf::Clock clock;
+	Headless::batch(jobs, routes, threads, limit);
+	float wall = clock.getElapsedTime().asSeconds();
+
+	// print results
+	size_t ticks = 0;
+	printf("%-14s %-24s %8s %10s %4s %6s %7s %16s\n", "level", "input", "ticks", "time", "exit", "deaths", "prisms", "hash");
+	for (const Headless::Job& job : jobs) {
+		const Headless::Result& res = job.result;
+		char prisms[16];
+		snprintf(prisms, sizeof(prisms), "%u/%u", res.pcol, res.pttl);
+		printf("%-14s %-24s %8llu %10s %4s %6llu %7s %016llx\n",
+			job.name.c_str(), job.file.c_str(), (unsigned long long)res.ticks, Data::Time::repr(res.time),
+			res.exit ? "yes" : "no", (unsigned long long)res.deaths, prisms, (unsigned long long)res.hash);
+		ticks += res.ticks;
+	};
+	printf("%llu jobs, %llu threads, %llu ticks in %.3f s (%.0f ticks/s)\n",
+		(unsigned long long)jobs.size(), (unsigned long long)std::max<size_t>(threads, 1),
+		(unsigned long long)ticks, wall, wall > 0.0f ? ticks / wall : 0.0f);
+	return 0;
+};
+
+/// Level solver entry.
+/// @return Exit code.
+int solve(int argcount, const char** args) {
+	const char* name = args[2];
+	const char* output = NULL;
+	size_t threads = std::thread::hardware_concurrency();
+	size_t limit = 100000;
+
+	// parse command line arguments
+	for (int i = 3; i < argcount; i++) {
+		if (strcmp(args[i], "-n") == 0 && i + 1 < argcount)
+			threads = strtoull(args[++i], NULL, 10);
+		else if (strcmp(args[i], "-m") == 0 && i + 1 < argcount)
+			limit = strtoull(args[++i], NULL, 10);
+		else if (strcmp(args[i], "-o") == 0 && i + 1 < argcount)
+			output = args[++i];
+		else {
+			usage();
+			return 1;
+		};
+	};
+
+	// load level data
+	Data::World world({});
+	const Bytes::Level* data = loadLevel(world, name);
+	if (data == NULL) return 0xbad;
+
+	// run solver
+	Solver::Solver solver(*data, threads);
+	Solver::Result res = solver.solve(limit);
+	printf("level  = %s\n", name);
+	printf("states = %llu simulated, %llu unique\n", (unsigned long long)res.expanded, (unsigned long long)res.unique);
+	printf("prisms = %u/%u reachable\n", res.reach, res.pttl);
+	if (res.exit)
+		printf("exit   = %llu ticks (%llu events)\n", (unsigned long long)res.ticks, (unsigned long long)res.path.evts.size());
+	else
+		printf("exit   = not found\n");
+	printf("speed  = %.0f states/s\n", res.wall > 0.0f ? res.expanded / res.wall : 0.0f);
+
+	// write fastest path
+	if (res.exit) {
+		FILE* file = output ? fopen(output, "w") : stdout;
+		if (file == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", output, strerror(errno));
+			return 0xbad;
+		};
+		Solver::print(file, res.path);
+		if (file != stdout) fclose(file);
+	};
+	return 0;
+};
+
+/// Headless simulation entry.
+/// @return Exit code.
+int main(int argcount, const char** args) {
+	const char* name = NULL;
+	const char* input = NULL;
+	long route = -1;
+	size_t limit = 36000;
+	bool logs = false;
+	size_t rewind = 0;
+	const char* trace = NULL;
+	const char* reference = NULL;
+
+	// run broadphase benchmark
+	if (argcount == 2 && strcmp(args[1], "-b") == 0) {
+		printf("%8s %10s %12s %12s %12s\n", "plats", "hits", "brute us/q", "grid us/q", "update us");
+		for (size_t count : { 10, 30, 50, 100, 300, 1000 }) {
+			Headless::Bench res = Headless::bench(count);
+			printf("%8llu %10llu %12.3f %12.3f %12.3f%s\n",
+				(unsigned long long)res.count, (unsigned long long)res.hits,
+				res.brute, res.grid, res.update, res.match ? "" : "  MISMATCH");
+		};
+		return 0;
+	};
+
+	// run element kernel benchmark
+	if (argcount == 2 && strcmp(args[1], "-k") == 0) {
+		printf("%8s %10s %10s %12s %12s\n", "plats", "aos B/pl", "soa B/pl", "aos us/step", "soa us/step");
+		for (size_t count : { 100, 1000, 10000, 100000 }) {
+			Headless::Kernels res = Headless::kernels(count);
+			printf("%8llu %10llu %10llu %12.3f %12.3f%s\n",
+				(unsigned long long)res.count, (unsigned long long)res.aos, (unsigned long long)res.soa,
+				res.legacy, res.lists, res.match ? "" : "  MISMATCH");
+		};
+		return 0;
+	};
+
+	// run batch replay
+	if (argcount >= 2 && strcmp(args[1], "-p") == 0)
+		return batch(argcount, args);
+
+	// run level solver
+	if (argcount >= 3 && strcmp(args[1], "-s") == 0)
+		return solve(argcount, args);
+
+	// parse command line arguments
+	for (int i = 1; i < argcount; i++) {
+		if (strcmp(args[i], "-i") == 0 && i + 1 < argcount)
+			input = args[++i];
+		else if (strcmp(args[i], "-r") == 0 && i + 1 < argcount)
+			route = atol(args[++i]);
+		else if (strcmp(args[i], "-t") == 0 && i + 1 < argcount)
+			limit = strtoull(args[++i], NULL, 10);
+		else if (strcmp(args[i], "-l") == 0)
+			logs = true;
+		else if (strcmp(args[i], "-w") == 0 && i + 1 < argcount)
+			rewind = strtoull(args[++i], NULL, 10) << 10;
+		else if (strcmp(args[i], "-h") == 0 && i + 1 < argcount)
+			trace = args[++i];
+		else if (strcmp(args[i], "-d") == 0 && i + 1 < argcount)
+			reference = args[++i];
+		else if (args[i][0] != '-' && name == NULL)
+			name = args[i];
+		else {
+			usage();
+			return 1;
+		};
+	};
+	if (name == NULL) {
+		usage();
+		return 1;
+	};
+
+	// open logging file
+	if (logs) {
+		Log::out.setStream(fopen("logs.txt", "w"));
+		Log::out.color = false;
+	};
+
+	// load route data
+	Bytes::Routes routedata;
+	if (route >= 0) {
+		if (!loadRoutes(routedata)) return 0xbad;
+		if ((size_t)route >= routedata.routes.size()) {
+			fprintf(stderr, "Route %ld does not exist.\n", route);
+			return 1;
+		};
+	};
+
+	// load level data
+	Data::World world(routedata);
+	const Bytes::Level* data = loadLevel(world, name);
+	if (data == NULL) return 0xbad;
+
+	// create simulation
+	Headless::Runner runner(*data, route >= 0);
+	if (route >= 0)
+		runner.route(routedata, route);
+
+	// enable rewind capture
+	runner.level.timeline = Level::Rewind(rewind);
+
+	// open hash traces
+	if (trace) {
+		runner.level.trace = fopen(trace, "w");
+		if (runner.level.trace == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", trace, strerror(errno));
+			return 0xbad;
+		};
+	};
+	if (reference) {
+		FILE* file = fopen(reference, "r");
+		if (file == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", reference, strerror(errno));
+			return 0xbad;
+		};
+		runner.compare(file);
+		fclose(file);
+	};
+
+	// load input stream
+	if (input) {
+		FILE* file = strcmp(input, "-") == 0 ? stdin : fopen(input, "r");
+		if (file == NULL) {
+			fprintf(stderr, "Could not open <%s>: %s\n", input, strerror(errno));
+			return 0xbad;
+		};
+		runner.drive(Bytes::Path().parse(file));
+		if (file != stdin) fclose(file);
+	};
+
+	// run simulation
+	Headless::Result res = runner.run(limit);
+	printf("level  = %s\n", name);
+	printf("ticks  = %llu\n", (unsigned long long)res.ticks);
+	printf("time   = %s\n", Data::Time::repr(res.time));
+	printf("exit   = %s\n", res.exit ? "yes" : "no");
+	printf("deaths = %llu\n", (unsigned long long)res.deaths);
+	printf("prisms = %u/%u\n", res.pcol, res.pttl);
+	printf("pos    = %.3f, %.3f, %.3f\n", (float)res.pos.x, (float)res.pos.y, (float)res.pos.z);
+	printf("hash   = %016llx\n", (unsigned long long)res.hash);
+	if (reference) {
+		if (res.diff == -1ULL)
+			printf("diff   = none\n");
+		else
+			printf("diff   = tick %llu\n", (unsigned long long)res.diff);
+	};
+	printf("speed  = %.0f ticks/s\n", res.wall > 0.0f ? res.ticks / res.wall : 0.0f);
+	if (rewind) {
+		const Level::Rewind& timeline = runner.level.timeline;
+		const float capture = runner.level.captures ? runner.level.captureTime.asSeconds() / runner.level.captures : 0.0f;
+		printf("rewind = %llu frames, %llu KiB, frame %llu bytes, capture %.2f us (%.2f%% of a step)\n",
+			(unsigned long long)timeline.size(), (unsigned long long)(timeline.bytes() >> 10),
+			(unsigned long long)runner.level.snapshot.size(), capture * 1e6f, capture / Timers::step * 100.0f);
+	};
+
+	// success
+	if (runner.level.trace) fclose(runner.level.trace);
+	Log::out.print();
+	return 0;
+};
@@ -0,0 +1,510 @@
+#pragma once
+
+/// Headless simulation namespace.
+namespace Headless {
+	/// Simulation result object.
+	struct Result {
+		size_t  ticks; // Simulated tick count.
+		size_t deaths; // Player death count.
+		uint16_t pcol; // Collected prism count.
+		uint16_t pttl; // Total prism count.
+		bool     exit; // Whether the level was completed.
+		vec3x     pos; // Final player position.
+		uint32_t time; // Level time in milliseconds.
+		float    wall; // Elapsed real time in seconds.
+		uint64_t hash; // Final state hash.
+		size_t   diff; // First tick diverging from reference trace.
+	};
+
+	/// Level simulation runner.
+	/// @note Runner never generates models, so no window or OpenGL context is required.
+	struct Runner {
+		/// Simulated level.
+		Level::Level level;
+		/// Replayed player input.
+		Bytes::Path input;
+		/// Whether the player is driven by replayed input.
+		bool replay;
+		/// Simulated tick count.
+		size_t ticks;
+		/// Reference state hashes of each tick.
+		std::vector<uint64_t> expect;
+		/// First tick diverging from reference hashes.
+		size_t diff = -1ULL;
+
+		/// Runner constructor.
+		/// @param data Level data.
+		/// @param world Whether the level is a worldmap.
+		Runner (const Bytes::Level& data, bool world = false):
+			level(data, world), replay(false), ticks(0)
+		{
+			level.initCheckpoint();
+		};
+
+		/// Copy constructor.
+		/// @note Player keymap references runner input.
+		Runner (const Runner& runner) = delete;
+		/// Copy assignment.
+		/// @note Player keymap references runner input.
+		Runner& operator=(const Runner& runner) = delete;
+
+		/// Drives the player with an input path.
+		/// @param path Input path.
+		void drive(const Bytes::Path& path) {
+			input = path;
+			replay = true;
+			level.drive(&input);
+		};
+
+		/// Drives the player along a world map route.
+		/// @param routes World map route data.
+		/// @param idx Route index.
+		/// @note All previous routes are treated as completed.
+		void route(const Bytes::Routes& routes, size_t idx) {
+			// apply completed routes
+			std::vector<size_t> done;
+			for (size_t i = 0; i < idx; i++)
+				done.push_back(i);
+			level.effect(routes, done);
+
+			// warp cube to route start
+			const Bytes::Route& route = routes.routes[idx];
+			level.getPlayer().tile = route.pos;
+			if (route.mini) level.getPlayer().shrink();
+			level.initCheckpoint();
+
+			// start walking
+			drive(route.path);
+		};
+
+		/// Loads reference state hashes from a trace.
+		/// @param trace Trace file written by a previous run.
+		void compare(FILE* trace) {
+			unsigned long long step, hash;
+			while (fscanf(trace, "%llu %llx", &step, &hash) == 2) {
+				if (step == 0) continue;
+				if (expect.size() < step) expect.resize(step);
+				expect[step - 1] = hash;
+			};
+		};
+
+		/// Checks whether the simulation has finished.
+		bool done() {
+			if (level.exitReq) return true;
+
+			// check for input end
+			Level::Cube& player = level.getPlayer();
+			return replay && !player.keys.active() && player.act == Level::Cube::Idle;
+		};
+
+		/// Advances the simulation by one step.
+		/// @return Whether the simulation has finished.
+		bool tick() {
+			level.update(Timers::step);
+			ticks++;
+
+			// compare with reference trace
+			size_t step = level.steps;
+			if (diff == -1ULL && step <= expect.size() && level.hash() != expect[step - 1])
+				diff = step;
+			return done();
+		};
+
+		/// Runs the simulation until it finishes.
+		/// @param limit Maximum tick count.
+		/// @return Simulation result.
+		Result run(size_t limit) {
+			sf::Clock clock;
+			while (ticks < limit && !tick());
+
+			// collect results
+			Data::LevelData rank = level.rank();
+			Result result;
+			result.ticks = ticks;
+			result.deaths = level.deaths;
+			result.pcol = rank.pcol;
+			result.pttl = rank.pttl;
+			result.exit = level.exitReq;
+			result.pos = level.getPlayer().pos();
+			result.time = level.timer.total();
+			result.wall = clock.getElapsedTime().asSeconds();
+			result.hash = level.hash();
+			result.diff = diff;
+			return result;
+		};
+	};
+
+	/// Batch replay job object.
+	struct Job {
+		std::string          name; // Level name.
+		long                route; // World map route index (-1 if unused).
+		std::string          file; // Input file name.
+		Bytes::Path         input; // Replayed input.
+		const Bytes::Level*  data; // Loaded level data.
+		Result             result; // Simulation result.
+	};
+
+	/// Work-stealing thread pool.
+	/// @note Each worker pops tasks from the back of its own queue and steals from the front of others.
+	class Pool {
+		private:
+		/// Worker task queue.
+		struct Queue {
+			std::mutex          lock; // Queue lock.
+			std::deque<size_t> tasks; // Task indices.
+		};
+
+		/// Worker queues.
+		std::deque<Queue> queues;
+
+		/// Takes a task from own queue.
+		/// @param worker Worker index.
+		/// @param[out] task Task index.
+		/// @return Whether a task was taken.
+		bool pop(size_t worker, size_t& task) {
+			Queue& queue = queues[worker];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (queue.tasks.empty()) return false;
+			task = queue.tasks.back();
+			queue.tasks.pop_back();
+			return true;
+		};
+
+		/// Takes a task from another queue.
+		/// @param worker Worker index.
+		/// @param[out] task Task index.
+		/// @return Whether a task was stolen.
+		bool steal(size_t worker, size_t& task) {
+			for (size_t i = 1; i < queues.size(); i++) {
+				Queue& queue = queues[(worker + i) % queues.size()];
+				std::lock_guard<std::mutex> guard(queue.lock);
+				if (queue.tasks.empty()) continue;
+				task = queue.tasks.front();
+				queue.tasks.pop_front();
+				return true;
+			};
+			return false;
+		};
+
+		public:
+		/// Thread pool constructor.
+		/// @param threads Worker count.
+		Pool (size_t threads): queues(std::max<size_t>(threads, 1)) {};
+
+		/// Returns worker count.
+		size_t size() const { return queues.size(); };
+
+		/// Runs tasks on all workers until every task is done.
+		/// @param count Task count.
+		/// @param func Task function, called with task and worker index.
+		/// @note Tasks are dealt in contiguous blocks, so neighbouring tasks stay on one worker unless stolen.
+		void run(size_t count, const std::function<void(size_t, size_t)>& func) {
+			for (size_t i = 0; i < count; i++)
+				queues[i * queues.size() / count].tasks.push_front(i);
+
+			// start workers
+			auto work = [this, &func](size_t worker) {
+				size_t task;
+				while (pop(worker, task) || steal(worker, task))
+					func(task, worker);
+			};
+			std::vector<std::thread> threads;
+			for (size_t i = 1; i < queues.size(); i++)
+				threads.emplace_back(work, i);
+			work(0);
+
+			// wait for workers
+			for (std::thread& thread : threads)
+				thread.join();
+		};
+	};
+
+	/// Simulates replay jobs in parallel.
+	/// @param jobs Job list with loaded level data.
+	/// @param routes World map route data.
+	/// @param threads Worker count.
+	/// @param limit Maximum tick count of each job.
+	/// @note Every job simulates its own level copy, and workers share only read-only level data.
+	void batch(std::vector<Job>& jobs, const Bytes::Routes& routes, size_t threads, size_t limit) {
+		Pool pool(threads);
+		pool.run(jobs.size(), [&jobs, &routes, limit](size_t idx, size_t worker) {
+			Job& job = jobs[idx];
+			Runner runner(*job.data, job.route >= 0);
+			if (job.route >= 0)
+				runner.route(routes, job.route);
+			else if (!job.file.empty())
+				runner.drive(job.input);
+			job.result = runner.run(limit);
+		});
+	};
+
+	/// Broadphase benchmark result object.
+	struct Bench {
+		size_t  count; // Moving platform count.
+		size_t   hits; // Intersecting pair count.
+		float   brute; // Linear scan time in microseconds per query.
+		float    grid; // Broadphase time in microseconds per query.
+		float  update; // Index update time in microseconds per step.
+		bool    match; // Whether both methods found the same platforms.
+	};
+
+	/// Compares moving platform broadphase against a linear scan.
+	/// @param count Moving platform count.
+	/// @param queries Query count.
+	/// @return Benchmark result.
+	/// @note Platforms are scattered at 1 platform per 16 tiles of floor.
+	Bench bench(size_t count, size_t queries = 100000) {
+		srand(count);
+		int side = (int)sqrtf(count * 16.0f) + 1;
+		auto coord = [side]() { return fix((float)(rand() % (side * 16)) / 16.0f); };
+
+		// generate platforms
+		Bytes::Moving data;
+		data.half = false;
+		data.active = false;
+		Level::MovingPlats plats;
+		for (size_t i = 0; i < count; i++) {
+			plats.add(&data);
+			plats.now[i] = vec3x(coord(), coord(), fix(rand() % 4));
+		};
+
+		// generate cube volumes
+		std::vector<vol3x> cubes;
+		for (size_t i = 0; i < queries; i++)
+			cubes.push_back(vol3x(vec3x(coord(), coord(), fix(rand() % 4)), vec3x(1, 1, 2)));
+
+		Bench bench;
+		bench.count = count;
+		bench.hits = 0;
+		bench.match = true;
+		Level::Broadphase grid;
+		grid.build(plats);
+
+		// time linear scan
+		sf::Clock clock;
+		std::vector<size_t> brute;
+		for (const vol3x& cube : cubes) {
+			for (size_t i = 0; i < plats.size(); i++) {
+				if (cube.intersects(plats.volume(i)))
+					brute.push_back(i);
+			};
+		};
+		bench.brute = clock.restart().asMicroseconds() / (float)queries;
+
+		// time broadphase
+		size_t ptr = 0;
+		for (const vol3x& cube : cubes) {
+			for (size_t i : grid.query(cube)) {
+				if (!cube.intersects(plats.volume(i))) continue;
+				if (ptr >= brute.size() || brute[ptr] != i) bench.match = false;
+				ptr++;
+			};
+		};
+		bench.grid = clock.restart().asMicroseconds() / (float)queries;
+		bench.hits = brute.size();
+		if (ptr != brute.size()) bench.match = false;
+
+		// time incremental updates
+		const size_t steps = 1000;
+		for (size_t s = 0; s < steps; s++) {
+			for (vec3x& now : plats.now)
+				now.x += fix(1.0f / 16.0f);
+			grid.update(plats);
+		};
+		bench.update = clock.restart().asMicroseconds() / (float)steps;
+		return bench;
+	};
+
+	/// Platform records in the array of structs layout preceding element lists.
+	/// @note Only kept as a benchmark reference, so cold pointers stay in to keep original record sizes.
+	namespace Legacy {
+		/// Moving platform record.
+		struct Moving {
+			const Bytes::Moving* root; // Moving platform data.
+			vec3x now, prev, start;    // Current, previous & waypoint start position.
+			uint16_t waypoint;         // Waypoint pointer.
+			uint32_t time;             // Current waypoint time in ticks.
+			Object* object;            // Platform model.
+			bool pactive, active;      // Previous & current active value.
+
+			/// Checks whether updates leave the platform unchanged.
+			bool idle() const { return waypoint == 0xffff && !active && !pactive && prev == now && now == start; };
+
+			/// Updates moving platform state.
+			/// @param delta Elapsed time since last frame.
+			/// @note Follows the original update, except for the tick timer the element lists switch waypoints with.
+			void update(float delta) {
+				prev = now;
+				pactive = active;
+
+				// update waypoint
+				if (waypoint != 0xffff) {
+					time += Level::convTime(delta);
+
+					// check for new waypoint
+					if (time >= root->ways[waypoint].total) {
+						time = 0;
+						start = root->ways[waypoint].dest;
+						switch (root->ways[waypoint].after) {
+							case Bytes::Waypoint::Halt: waypoint = 0xffff; break;
+							case Bytes::Waypoint::Next: waypoint++;        break;
+							case Bytes::Waypoint::Loop: waypoint = 0;      break;
+						};
+					};
+
+					// check if new waypoint exists
+					if (waypoint != 0xffff) {
+						active = time < root->ways[waypoint].time;
+						if (active) {
+							fix t = (fix)((float)time / root->ways[waypoint].time);
+							now = vec3x::lerp(start, root->ways[waypoint].dest, t);
+						} else
+							now = root->ways[waypoint].dest;
+					} else {
+						active = false;
+						now = start;
+					};
+				} else {
+					active = false;
+					now = start;
+				};
+
+				// clamp position
+				now = vec3x((now.x * 64fx).round() / 64fx, (now.y * 64fx).round() / 64fx, (now.z * 64fx).round() / 64fx);
+			};
+		};
+
+		/// Falling platform record.
+		struct Falling {
+			const Bytes::Falling* root;         // Falling platform data.
+			vec3x pos, prev;                    // Current & previous position.
+			fix speedz;                         // Vertical speed.
+			float left;                         // Unstable time left.
+			Level::FallingPlats::State state;   // Platform state.
+
+			/// Checks whether updates leave the platform unchanged.
+			bool idle() const { return prev == pos && (state == Level::FallingPlats::Solid || (state == Level::FallingPlats::Fall && pos.z <= -16fx)); };
+
+			/// Updates falling platform state.
+			/// @param delta Elapsed time since last frame.
+			void update(float delta) {
+				prev = pos;
+				if (state == Level::FallingPlats::Decay) {
+					if (left < delta) { speedz = 0fx; state = Level::FallingPlats::Fall; }
+					else left -= delta;
+				} else if (state == Level::FallingPlats::Fall && pos.z > -16fx) {
+					speedz = (speedz + 0.125fx).clamp(0fx, 0.22fx);
+					pos.z -= speedz;
+				};
+			};
+		};
+	};
+
+	/// Element list benchmark result object.
+	struct Kernels {
+		size_t  count; // Platform count of each type.
+		size_t    aos; // Record bytes per moving & falling platform.
+		size_t    soa; // Hot lane bytes per moving & falling platform.
+		float  legacy; // Array of structs update time in microseconds per step.
+		float   lists; // Element list update time in microseconds per step.
+		bool    match; // Whether both layouts reached the same state.
+	};
+
+	/// Compares element list update kernels against the array of structs layout.
+	/// @param count Moving & falling platform count.
+	/// @param steps Simulated step count.
+	/// @return Benchmark result.
+	/// @note Every other moving platform loops between 2 waypoints, the rest is halted.
+	/// @note Every 8th falling platform is triggered at the start.
+	Kernels kernels(size_t count, size_t steps = 1000) {
+		srand(count);
+		int side = (int)sqrtf(count * 16.0f) + 1;
+		auto coord = [side]() { return fix(rand() % side); };
+
+		// generate synthetic level data
+		std::vector<Bytes::Moving> movings(count);
+		std::vector<Bytes::Falling> fallings(count);
+		for (size_t i = 0; i < count; i++) {
+			Bytes::Moving& moving = movings[i];
+			moving.start = vec3x(coord(), coord(), fix(rand() % 4));
+			moving.half = false;
+			moving.active = i % 2 == 0;
+			moving.ways.push_back({ moving.start + vec3x(4, 0, 0), (uint64_t)(rand() % 120 + 60), 240, Bytes::Waypoint::Next });
+			moving.ways.push_back({ moving.start, 120, 240, Bytes::Waypoint::Loop });
+
+			Bytes::Falling& falling = fallings[i];
+			falling.pos = vec3x(coord(), coord(), fix(rand() % 4));
+			falling.time = rand() % 240;
+		};
+
+		// instantiate both layouts
+		Level::MovingPlats movingPlats;
+		Level::FallingPlats fallingPlats;
+		std::vector<Legacy::Moving> movingRecs;
+		std::vector<Legacy::Falling> fallingRecs;
+		for (size_t i = 0; i < count; i++) {
+			movingPlats.add(&movings[i]);
+			movingRecs.push_back({ &movings[i], vec3x(), vec3x(), movings[i].start, movingPlats.waypoint[i], 0, NULL, false, false });
+			fallingPlats.add(&fallings[i]);
+			fallingRecs.push_back({ &fallings[i], fallings[i].pos, fallings[i].pos, 0fx, 0.0f, Level::FallingPlats::Solid });
+			if (i % 8 == 0) {
+				fallingPlats.trigger(i);
+				fallingRecs[i].left = fallingPlats.left[i];
+				fallingRecs[i].state = Level::FallingPlats::Decay;
+			};
+		};
+
+		Kernels bench;
+		bench.count = count;
+		bench.aos = sizeof(Legacy::Moving) + sizeof(Legacy::Falling);
+		bench.soa = sizeof(vec3x) * 5 + sizeof(uint16_t) + sizeof(uint32_t) + sizeof(float) + sizeof(uint8_t) * 3 + sizeof(fix) + sizeof(Level::FallingPlats::State);
+		bench.match = true;
+		Level::Dirty changes[2];
+		changes[0].reset(count);
+		changes[1].reset(count);
+
+		// array of structs update step
+		auto legacy = [&]() {
+			for (size_t i = 0; i < count; i++) {
+				if (!movingRecs[i].idle()) changes[0].mark(i);
+				movingRecs[i].update(Timers::step);
+			};
+			for (size_t i = 0; i < count; i++) {
+				if (!fallingRecs[i].idle()) changes[1].mark(i);
+				fallingRecs[i].update(Timers::step);
+			};
+		};
+
+		// element list update step
+		auto lists = [&]() {
+			movingPlats.update(Timers::step, changes[0]);
+			fallingPlats.update(Timers::step, changes[1]);
+		};
+
+		// warm up both layouts
+		legacy();
+		lists();
+
+		// time both layouts step by step, alternating which one runs first
+		sf::Clock clock;
+		sf::Int64 total[2] = { 0, 0 };
+		for (size_t s = 0; s < steps; s++) {
+			for (int k = 0; k < 2; k++) {
+				int run = (s + k) % 2;
+				clock.restart();
+				if (run == 0) legacy();
+				else lists();
+				total[run] += clock.getElapsedTime().asMicroseconds();
+			};
+		};
+		bench.legacy = total[0] / (float)steps;
+		bench.lists = total[1] / (float)steps;
+
+		// compare final states
+		for (size_t i = 0; i < count; i++) {
+			if (movingRecs[i].now != movingPlats.now[i]) bench.match = false;
+			if (fallingRecs[i].pos != fallingPlats.pos[i]) bench.match = false;
+		};
+		return bench;
+	};
+};
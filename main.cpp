@@ -39,6 +39,7 @@ namespace sf { typedef Vector3<unsigned int> Vector3u; };
 #include "types.hpp"
 #include "files/file.hpp"
 #include "logging.hpp"
+#include "glstate.hpp"
 #include "shaders.hpp"
 #include "texture.hpp"
 #include "assets.hpp"
@@ -47,6 +48,7 @@ namespace sf { typedef Vector3<unsigned int> Vector3u; };
 #include "timers.hpp"
 #include "vertex.hpp"
 #include "object.hpp"
+#include "queue.hpp"
 #include "render.hpp"
 #include "window.hpp"
 #include "camera.hpp"
@@ -69,6 +71,8 @@ int main(int argcount, const char** args) {
 			Win::fullscreen = true;
 		if (strcmp(args[i], "-v") == 0)
 			Win::vsync = true;
+		if (strcmp(args[i], "-r") == 0 && i + 1 < argcount)
+			Level::rewindBudget = strtoull(args[++i], NULL, 10) << 20;
 	};
 
 	// open logging file
@@ -131,6 +135,13 @@ int main(int argcount, const char** args) {
 
 	// bind texture 0 for rendering
 	Tex::useSlot(Shaders::tex, "tex", 0);
+	Tex::useSlot(Shaders::tex, "rainbow", 1);
+	Tex::useSlot(Shaders::dst, "tex", 0);
+	Tex::useSlot(Shaders::dst, "rainbow", 1);
+	Tex::useSlot(Shaders::ter, "tex", 0);
+
+	// send terrain tile table
+	Models::Terrain::sendTiles(Shaders::ter);
 
 	// start loading files
 	Log::out.separator("Loading data");
@@ -29,6 +29,7 @@ namespace Models {
 				for (GLuint i = 0; i < 4; i++)
 					buffer[f * 4 + i] = Vertex(vertID(min, max, faces[f][i]), Textures::Mask::white.coords[i]);
 			};
+			Prism::weigh(buffer);
 
 			// update geometry
 			object.set(buffer, lengthof(buffer));
@@ -46,14 +47,14 @@ namespace Models {
 		};
 
 		/// Cube roll animation.
-		/// @param object Cube model.
-		/// @param shadow Shadow model.
+		/// @param object Cube model (may be `NULL`).
+		/// @param shadow Shadow model (may be `NULL`).
 		/// @param dir Animation direction.
 		/// @param t Animation progress.
 		/// @param settings Animation settings.
 		/// @note The roll displaces cube from (0, 0, 0) to unit direction vector R * (x, 0, z).
 		/// @return Animation collision volume.
-		vol3x roll(Object& object, Object& shadow, Direction dir, fix t, const Settings& settings) {
+		vol3x roll(Object* object, Object* shadow, Direction dir, fix t, const Settings& settings) {
 			// calculate cosine & sine values
 			float cosv = cosf((float)t * M_PI_2);
 			float sinv = sinf((float)t * M_PI_2);
@@ -94,7 +95,7 @@ namespace Models {
 					verts[5] = glm::vec3(n2.x, n2.y, pf);
 					verts[6] = glm::vec3(n3.x, n3.y, nf);
 					verts[7] = glm::vec3(n3.x, n3.y, pf);
-					Shadow::update(shadow, {n1.x, nf}, {n2.x, pf}, settings.shadow, -0.5f);
+					if (shadow) Shadow::update(*shadow, {n1.x, nf}, {n2.x, pf}, settings.shadow, -0.5f);
 					break;
 				case West:
 					verts[0] = glm::vec3(p0.x, p0.y, nf);
@@ -105,7 +106,7 @@ namespace Models {
 					verts[5] = glm::vec3(p2.x, p2.y, pf);
 					verts[6] = glm::vec3(p3.x, p3.y, nf);
 					verts[7] = glm::vec3(p3.x, p3.y, pf);
-					Shadow::update(shadow, {p0.x, nf}, {p3.x, pf}, settings.shadow, -0.5f);
+					if (shadow) Shadow::update(*shadow, {p0.x, nf}, {p3.x, pf}, settings.shadow, -0.5f);
 					break;
 				case North:
 					verts[0] = glm::vec3(nf, n0.y, n0.x);
@@ -116,7 +117,7 @@ namespace Models {
 					verts[5] = glm::vec3(pf, n2.y, n2.x);
 					verts[6] = glm::vec3(pf, n1.y, n1.x);
 					verts[7] = glm::vec3(pf, n3.y, n3.x);
-					Shadow::update(shadow, {nf, n1.x}, {pf, n2.x}, settings.shadow, -0.5f);
+					if (shadow) Shadow::update(*shadow, {nf, n1.x}, {pf, n2.x}, settings.shadow, -0.5f);
 					break;
 				case South:
 					verts[0] = glm::vec3(nf, p0.y, p0.x);
@@ -127,16 +128,18 @@ namespace Models {
 					verts[5] = glm::vec3(pf, p2.y, p2.x);
 					verts[6] = glm::vec3(pf, p1.y, p1.x);
 					verts[7] = glm::vec3(pf, p3.y, p3.x);
-					Shadow::update(shadow, {nf, p0.x}, {pf, p3.x}, settings.shadow, -0.5f);
+					if (shadow) Shadow::update(*shadow, {nf, p0.x}, {pf, p3.x}, settings.shadow, -0.5f);
 					break;
 				default:
 					break;
 			};
 
 			// update vertices
-			for (GLuint f = 0; f < 6; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setPos(verts[faces[f][i]]);
+			if (object) {
+				for (GLuint f = 0; f < 6; f++) {
+					for (GLuint i = 0; i < 4; i++)
+						object->vertices()[f * 4 + i].setPos(verts[faces[f][i]]);
+				};
 			};
 
 			// calculate collision volume
@@ -147,14 +150,14 @@ namespace Models {
 		};
 
 		/// Cube hanging animation.
-		/// @param object Cube model object.
-		/// @param shadow Shadow model.
+		/// @param object Cube model object (may be `NULL`).
+		/// @param shadow Shadow model (may be `NULL`).
 		/// @param dir Animation direction.
 		/// @param t Animation progress.
 		/// @param settings Animation settings.
 		/// @note The roll displaces cube from (0, 0, 0) to R * (0, 1, 0).
 		/// @return Animation collision volume.
-		vol3x hang(Object& object, Object& shadow, Direction dir, fix t, const Settings& settings) {
+		vol3x hang(Object* object, Object* shadow, Direction dir, fix t, const Settings& settings) {
 			/// 0 = X-Y-
 			/// 1 = X-Y+
 			/// 2 = X+Y-
@@ -196,7 +199,7 @@ namespace Models {
 					verts[5] = glm::vec3(n2.x, n2.y, pf);
 					verts[6] = glm::vec3(n3.x, n3.y, nf);
 					verts[7] = glm::vec3(n3.x, n3.y, pf);
-					Shadow::wall(shadow, {n1.x, nf}, {n2.x, pf}, settings.shadow, -0.5f, R, sinv, dir);
+					if (shadow) Shadow::wall(*shadow, {n1.x, nf}, {n2.x, pf}, settings.shadow, -0.5f, R, sinv, dir);
 					break;
 				case West:
 					verts[0] = glm::vec3(p0.x, p0.y, nf);
@@ -207,7 +210,7 @@ namespace Models {
 					verts[5] = glm::vec3(p2.x, p2.y, pf);
 					verts[6] = glm::vec3(p3.x, p3.y, nf);
 					verts[7] = glm::vec3(p3.x, p3.y, pf);
-					Shadow::wall(shadow, {p3.x, nf}, {p0.x, pf}, settings.shadow, -0.5f, R, sinv, dir);
+					if (shadow) Shadow::wall(*shadow, {p3.x, nf}, {p0.x, pf}, settings.shadow, -0.5f, R, sinv, dir);
 					break;
 				case North:
 					verts[0] = glm::vec3(nf, n0.y, n0.x);
@@ -218,7 +221,7 @@ namespace Models {
 					verts[5] = glm::vec3(pf, n2.y, n2.x);
 					verts[6] = glm::vec3(pf, n1.y, n1.x);
 					verts[7] = glm::vec3(pf, n3.y, n3.x);
-					Shadow::wall(shadow, {nf, n1.x}, {pf, n2.x}, settings.shadow, -0.5f, R, sinv, dir);
+					if (shadow) Shadow::wall(*shadow, {nf, n1.x}, {pf, n2.x}, settings.shadow, -0.5f, R, sinv, dir);
 					break;
 				case South:
 					verts[0] = glm::vec3(nf, p0.y, p0.x);
@@ -229,16 +232,18 @@ namespace Models {
 					verts[5] = glm::vec3(pf, p2.y, p2.x);
 					verts[6] = glm::vec3(pf, p1.y, p1.x);
 					verts[7] = glm::vec3(pf, p3.y, p3.x);
-					Shadow::wall(shadow, {nf, p3.x}, {pf, p0.x}, settings.shadow, -0.5f, R, sinv, dir);
+					if (shadow) Shadow::wall(*shadow, {nf, p3.x}, {pf, p0.x}, settings.shadow, -0.5f, R, sinv, dir);
 					break;
 				default:
 					break;
 			};
 
 			// update vertices
-			for (GLuint f = 0; f < 6; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setPos(verts[faces[f][i]]);
+			if (object) {
+				for (GLuint f = 0; f < 6; f++) {
+					for (GLuint i = 0; i < 4; i++)
+						object->vertices()[f * 4 + i].setPos(verts[faces[f][i]]);
+				};
 			};
 
 			// calculate collision volume
@@ -249,13 +254,13 @@ namespace Models {
 		};
 
 		/// Cube resize animation.
-		/// @param object Cube model object.
-		/// @param shadow Shadow model.
+		/// @param object Cube model object (may be `NULL`).
+		/// @param shadow Shadow model (may be `NULL`).
 		/// @param t Animation progress (0 = normal, 1 = small).
 		/// @param shadowZ Shadow height output.
 		/// @param size Cube size output.
 		/// @return Animation collision volume.
-		vol3x resize(Object& object, Object& shadow, fix t, float& shadowZ, fix& size) {
+		vol3x resize(Object* object, Object* shadow, fix t, float& shadowZ, fix& size) {
 			// calculate animation interpolator
 			float i = sinf((float)t * M_PI_2);
 
@@ -271,14 +276,16 @@ namespace Models {
 			glm::vec3 max = glm::vec3( h, s - 0.5f,  h);
 
 			// update cube vertices
-			for (GLuint f = 0; f < 6; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setPos(vertID(min, max, faces[f][i]));
+			if (object) {
+				for (GLuint f = 0; f < 6; f++) {
+					for (GLuint i = 0; i < 4; i++)
+						object->vertices()[f * 4 + i].setPos(vertID(min, max, faces[f][i]));
+				};
 			};
 
 			// update shadow
 			shadowZ = lerpf(Cube::shadowZ, Prism::shadowZ, i);
-			Shadow::update(shadow, glm::vec2(min.x, min.z), glm::vec2(max.x, max.z), shadowZ, -0.5f);
+			if (shadow) Shadow::update(*shadow, glm::vec2(min.x, min.z), glm::vec2(max.x, max.z), shadowZ, -0.5f);
 
 			// return collision volume
 			return vol3x::fromTo(vec3x::fromGL(min), vec3x::fromGL(max)) + vec3x(0.5fx);
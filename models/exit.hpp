@@ -8,24 +8,25 @@ namespace Models {
 		/// @param object Exit model.
 		void generate(Object& object) {
 			// generate vertices
+			// color weights select inner & outer face rainbow colors
 			Vertex buffer[12] {
 				// inner face vertices
-				Vertex({-0.5f, -0.5f, -0.5f}, Textures::Mask::white.coords[0]),
-				Vertex({-0.5f, -0.5f,  0.5f}, Textures::Mask::white.coords[1]),
-				Vertex({ 0.5f, -0.5f, -0.5f}, Textures::Mask::white.coords[2]),
-				Vertex({ 0.5f, -0.5f,  0.5f}, Textures::Mask::white.coords[3]),
+				Vertex({-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, Textures::Mask::white.coords[0]),
+				Vertex({-0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, Textures::Mask::white.coords[1]),
+				Vertex({ 0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, Textures::Mask::white.coords[2]),
+				Vertex({ 0.5f, -0.5f,  0.5f}, {1.0f, 0.0f, 0.0f}, Textures::Mask::white.coords[3]),
 
 				// outer face inner vertices
-				Vertex({-0.5f, -0.5f, -0.5f}, Textures::Mask::white.coords[0]),
-				Vertex({-0.5f, -0.5f,  0.5f}, Textures::Mask::white.coords[1]),
-				Vertex({ 0.5f, -0.5f, -0.5f}, Textures::Mask::white.coords[1]),
-				Vertex({ 0.5f, -0.5f,  0.5f}, Textures::Mask::white.coords[0]),
+				Vertex({-0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[0]),
+				Vertex({-0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[1]),
+				Vertex({ 0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[1]),
+				Vertex({ 0.5f, -0.5f,  0.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[0]),
 
 				// outer face outer vertices
-				Vertex({-1.5f, -0.5f, -1.5f}, Textures::Mask::white.coords[2]),
-				Vertex({-1.5f, -0.5f,  1.5f}, Textures::Mask::white.coords[3]),
-				Vertex({ 1.5f, -0.5f, -1.5f}, Textures::Mask::white.coords[3]),
-				Vertex({ 1.5f, -0.5f,  1.5f}, Textures::Mask::white.coords[2]),
+				Vertex({-1.5f, -0.5f, -1.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[2]),
+				Vertex({-1.5f, -0.5f,  1.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[3]),
+				Vertex({ 1.5f, -0.5f, -1.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[3]),
+				Vertex({ 1.5f, -0.5f,  1.5f}, {0.0f, 1.0f, 0.0f}, Textures::Mask::white.coords[2]),
 			};
 
 			// generate indices
@@ -39,19 +40,14 @@ namespace Models {
 			// update geometry
 			object.set(buffer, lengthof(buffer));
 			object.index(indices);
+
+			// set up rainbow colors
+			object.hue.rows = glm::ivec3(2);
+			object.hue.shift = glm::uvec3(0x40, 0xC0, 0x00);
 		};
 
 		/// Updates an exit model.
 		/// @param object Exit model.
-		void update(Object& object) {
-			// update inner face
-			for (GLuint i = 0; i < 4; i++)
-				object.vertices()[i].col = Rainbow::exitA();
-
-			// update outer faces
-			for (GLuint i = 4; i < 12; i++)
-				object.vertices()[i].col = Rainbow::exitB();
-			object.update();
-		};
+		void update(Object& object) { object.hue.timer = Timers::slow.value(); };
 	};
 };
\ No newline at end of file
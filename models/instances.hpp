@@ -2,51 +2,102 @@
 
 /// Model generation namespace.
 namespace Models {
+	/// Instanced model batch.
+	/// @note Element draws only queue instance positions, which are then submitted with a single draw call.
+	struct Batch {
+		/// Instanced model.
+		/// @note Model position should stay at origin, since instance positions are added on top of it.
+		Object model;
+		/// Model texture.
+		const Tex* tex;
+		/// Model draw layer.
+		RenderQueue::Layer layer;
+		/// Instance position buffer.
+		VertexBuffer buffer;
+		/// Queued instance positions.
+		std::vector<glm::vec3> queue;
+
+		/// Batch constructor.
+		/// @param tex Model texture.
+		/// @param layer Model draw layer.
+		/// @note Instance models are stored in packed vertex format.
+		Batch (const Tex& tex, RenderQueue::Layer layer):
+			model(GL_TRIANGLES, true), tex(&tex), layer(layer), buffer(NULL, 0, GL_STREAM_DRAW) {
+			model.instance(buffer);
+		};
+
+		/// Queues a model instance.
+		/// @param pos Instance position.
+		/// @return Drawn vertex count.
+		size_t add(glm::vec3 pos) {
+			queue.push_back(pos);
+			return model.count();
+		};
+
+		/// Submits all queued instances to the render queue.
+		/// @param pass Render pass.
+		/// @note Instance buffer is uploaded immediately, so the pass must be executed before next flush.
+		void flush(RenderQueue::Pass pass) {
+			if (queue.empty()) return;
+			buffer.reset((const float*)queue.data(), sizeof(glm::vec3) * queue.size());
+			RenderQueue::submit(pass, layer, Shaders::tex, *tex, model, queue.size());
+			queue.clear();
+		};
+	};
+
 	/// Model instances.
 	namespace Instances {
-		Object* hint      ; /// Hint shadow.
-		Object* falling[4]; /// Falling platforms.
-		Object* button [2]; /// Button states.
-		Object* resizer[2]; /// Resizer (in & out).
-		Object* helper    ; /// Helper object.
-		Object* prism  [4]; /// Prism and its shadow.
-		Object* moving [4]; /// Moving platform active highlight (full & half).
-		Object* exit      ; /// Exit highlight.
+		// import draw layers
+		using RenderQueue::Solid;
+		using RenderQueue::Blend;
+
+		Batch* hint      ; /// Hint shadow.
+		Batch* falling[4]; /// Falling platforms.
+		Batch* button [2]; /// Button states.
+		Batch* resizer[2]; /// Resizer (in & out).
+		Batch* helper    ; /// Helper object.
+		Batch* prism  [4]; /// Prism and its shadow.
+		Batch* moving [4]; /// Moving platform active highlight (full & half).
+		Batch* exit      ; /// Exit highlight.
 
 		/// Generates all instance models.
 		void generate() {
 			// generate hint
-			Hint::generate(*(hint = new Object));
+			Hint::generate((hint = new Batch(Assets::mask, Blend))->model);
 
 			// generate falling platforms
 			for (size_t i = 0; i < 4; i++)
-				Falling::generate(*(falling[i] = new Object), static_cast<Theme>(i));
+				Falling::generate((falling[i] = new Batch(Assets::plat, Solid))->model, static_cast<Theme>(i));
 
 			// generate buttons
 			for (size_t i = 0; i < 2; i++)
-				Button::generate(*(button[i] = new Object), i != 0);
+				Button::generate((button[i] = new Batch(Assets::plat, Solid))->model, i != 0);
 
 			// generate resizers
 			for (size_t i = 0; i < 2; i++)
-				Resizer::generate(*(resizer[i] = new Object));
+				Resizer::generate((resizer[i] = new Batch(Assets::mask, Blend))->model);
 
 			// generate helper
-			Helper::generate(*(helper = new Object));
+			Helper::generate((helper = new Batch(Assets::mask, Blend))->model);
 
 			// generate prisms
-			Prism::generate(*(prism[0] = new Object), *(prism[1] = new Object));
-			Prism::generate(*(prism[2] = new Object), *(prism[3] = new Object));
+			for (size_t i = 0; i < 4; i++)
+				prism[i] = new Batch(Assets::mask, Solid);
+			Prism::generate(prism[0]->model, prism[1]->model);
+			Prism::generate(prism[2]->model, prism[3]->model);
+			prism[0]->model.hue.rows = Rainbow::cubeRows;
+			prism[2]->model.hue.rows = Rainbow::darkRows;
 
 			// generate moving platform highlight
 			for (size_t i = 0; i < 4; i++)
-				Moving::highlight(*(moving[i] = new Object), (i & 1) != 0);
+				Moving::highlight((moving[i] = new Batch(Assets::mask, Blend))->model, (i & 1) != 0);
 			for (size_t i = 2; i < 4; i++) {
-				moving[i]->color = glm::vec3(0.0f);
-				moving[i]->alpha = 1 / 32.0f;
+				moving[i]->model.color = glm::vec3(0.0f);
+				moving[i]->model.alpha = 1 / 32.0f;
 			};
 
 			// generate exit
-			Models::Exit::generate(*(exit = new Object));
+			Models::Exit::generate((exit = new Batch(Assets::mask, Blend))->model);
 		};
 
 		/// Deallocates all instance models.
@@ -76,125 +127,98 @@ namespace Models {
 		/// @param Elapsed time since last update.
 		void animate(float delta) {
 			// animate resizers
-			Resizer::animateOut(*resizer[0]);
-			Resizer::animateIn (*resizer[1]);
+			Resizer::animateOut(resizer[0]->model);
+			Resizer::animateIn (resizer[1]->model);
 
 			// update helper color
-			helper->color = Rainbow::helper();
+			helper->model.color = Rainbow::helper();
 
 			// rotate prisms
-			prism[0]->rotZ += delta * 0.5f;
-			prism[1]->rotZ += delta * 0.5f;
-			prism[2]->rotZ += delta * 0.5f;
-			prism[3]->rotZ += delta * 0.5f;
-
-			// update rainbow prism color
-			Prism::colorX(*prism[0], Rainbow::prismX());
-			Prism::colorY(*prism[0], Rainbow::prismY());
-			Prism::colorZ(*prism[0], Rainbow::prismZ());
-			prism[0]->update();
-
-			// update dark prism color
-			Prism::colorX(*prism[2], Rainbow::darkPrismX());
-			Prism::colorY(*prism[2], Rainbow::darkPrismY());
-			Prism::colorZ(*prism[2], Rainbow::darkPrismZ());
-			prism[2]->update();
+			prism[0]->model.rotZ += delta * 0.5f;
+			prism[1]->model.rotZ += delta * 0.5f;
+			prism[2]->model.rotZ += delta * 0.5f;
+			prism[3]->model.rotZ += delta * 0.5f;
+
+			// update prism colors
+			prism[0]->model.hue.timer = Timers::fast.value();
+			prism[2]->model.hue.timer = Timers::fast.value();
 
 			// update moving platform highlight
-			moving[0]->color = Rainbow::moving();
-			moving[1]->color = Rainbow::moving();
+			moving[0]->model.color = Rainbow::moving();
+			moving[1]->model.color = Rainbow::moving();
 
 			// update exit colors
-			Models::Exit::update(*exit);
+			Models::Exit::update(exit->model);
+		};
+
+		/// Submits all queued instances to the render queue.
+		/// @param pass Render pass.
+		void flush(RenderQueue::Pass pass) {
+			exit->flush(pass);
+			for (Batch* batch : moving ) batch->flush(pass);
+			for (Batch* batch : falling) batch->flush(pass);
+			hint->flush(pass);
+			for (Batch* batch : resizer) batch->flush(pass);
+			for (Batch* batch : prism  ) batch->flush(pass);
+			for (Batch* batch : button ) batch->flush(pass);
+			helper->flush(pass);
 		};
 	};
 
-	/// Draws a hint shadow.
+	/// Queues a hint shadow.
 	/// @param pos Hint position.
 	/// @return Drawn vertex count.
-	size_t drawHint(glm::vec3 pos) {
-		Instances::hint->pos = pos;
-		return Instances::hint->draw(Shaders::tex);
-	};
+	size_t drawHint(glm::vec3 pos) { return Instances::hint->add(pos); };
 
-	/// Draws a falling platform.
+	/// Queues a falling platform.
 	/// @param pos Platform position.
 	/// @param theme Platform model theme.
 	/// @return Drawn vertex count.
-	size_t drawFalling(glm::vec3 pos, Theme theme) {
-		Instances::falling[theme]->pos = pos;
-		return Instances::falling[theme]->draw(Shaders::tex);
-	};
+	size_t drawFalling(glm::vec3 pos, Theme theme) { return Instances::falling[theme]->add(pos); };
 
-	/// Draws a button.
+	/// Queues a button.
 	/// @param pos Button position.
 	/// @param pressed Whether the button is pressed.
 	/// @return Drawn vertex count.
-	size_t drawButton(glm::vec3 pos, bool pressed) {
-		Instances::button[pressed]->pos = pos;
-		return Instances::button[pressed]->draw(Shaders::tex);
-	};
+	size_t drawButton(glm::vec3 pos, bool pressed) { return Instances::button[pressed]->add(pos); };
 
-	/// Draws a resizer.
+	/// Queues a resizer.
 	/// @param pos Resizer position.
 	/// @param shrink Whether the resizer shrinks the cube.
 	/// @return Drawn vertex count.
-	size_t drawResizer(glm::vec3 pos, bool shrink) {
-		Instances::resizer[shrink]->pos = pos;
-		return Instances::resizer[shrink]->draw(Shaders::tex);
-	};
+	size_t drawResizer(glm::vec3 pos, bool shrink) { return Instances::resizer[shrink]->add(pos); };
 
-	/// Draws a helper hologram.
+	/// Queues a helper hologram.
 	/// @param pos Helper position.
 	/// @return Drawn vertex count.
-	size_t drawHelper(glm::vec3 pos) {
-		Instances::helper->pos = pos;
-		return Instances::helper->draw(Shaders::tex);
-	};
+	size_t drawHelper(glm::vec3 pos) { return Instances::helper->add(pos); };
 
-	/// Draws a prism.
+	/// Queues a prism.
 	/// @param pos Prism position.
 	/// @param dark Whether the prism is dark.
 	/// @return Drawn vertex count.
-	size_t drawPrism(glm::vec3 pos, bool dark) {
-		size_t idx = dark ? 2 : 0;
-		Instances::prism[idx]->pos = pos;
-		return Instances::prism[idx]->draw(Shaders::tex);
-	};
+	size_t drawPrism(glm::vec3 pos, bool dark) { return Instances::prism[dark ? 2 : 0]->add(pos); };
 
-	/// Draws a prism's shadow.
+	/// Queues a prism's shadow.
 	/// @param pos Prism position.
 	/// @param dark Whether the prism is dark.
 	/// @return Drawn vertex count.
-	size_t drawPrismShadow(glm::vec3 pos, bool dark) {
-		size_t idx = dark ? 3 : 1;
-		Instances::prism[idx]->pos = pos;
-		return Instances::prism[idx]->draw(Shaders::tex);
-	};
+	size_t drawPrismShadow(glm::vec3 pos, bool dark) { return Instances::prism[dark ? 3 : 1]->add(pos); };
 
-	/// Draws an active moving platform highlight.
+	/// Queues an active moving platform highlight.
 	/// @param pos Highlight position.
 	/// @param half Highlight height.
 	/// @return Drawn vertex count.
-	size_t drawActive(glm::vec3 pos, bool half) {
-		Instances::moving[half]->pos = pos;
-		return Instances::moving[half]->draw(Shaders::tex);
-	};
+	size_t drawActive(glm::vec3 pos, bool half) { return Instances::moving[half]->add(pos); };
 
-	/// Draws an inactive moving platform highlight.
+	/// Queues an inactive moving platform highlight.
 	/// @param pos Highlight position.
 	/// @param half Highlight height.
 	/// @return Drawn vertex count.
-	size_t drawInactive(glm::vec3 pos, bool half) {
-		Instances::moving[2 + half]->pos = pos;
-		return Instances::moving[2 + half]->draw(Shaders::tex);
-	};
+	size_t drawInactive(glm::vec3 pos, bool half) { return Instances::moving[2 + half]->add(pos); };
 
-	/// Draws an exit.
+	/// Queues an exit.
 	/// @param pos Exit position.
 	/// @return Drawn vertex count.
-	size_t drawExit(glm::vec3 pos) {
-		Instances::exit->pos = pos;
-		return Instances::exit->draw(Shaders::tex);
-	};
+	size_t drawExit(glm::vec3 pos) { return Instances::exit->add(pos); };
 };
\ No newline at end of file
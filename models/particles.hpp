@@ -4,33 +4,91 @@
 namespace Models {
 	/// Particle object.
 	namespace Particle {
-		static Object* object = NULL;
-
-		/// Unloads particle model.
-		void unload() {
-			if (object)
-				delete object;
+		/// Dust instance data.
+		struct Instance {
+			glm::vec3 pos; // Dust position.
+			float     dim; // Dust size.
+			uint8_t   off; // Dust rainbow offset.
+			uint8_t  mode; // Dust rainbow mode.
 		};
 
-		/// Generates particle model.
-		Object& model() {
-			if (object == NULL) {
+		/// Instanced dust renderer.
+		/// @note Particle quad is shared by all instances, while instance data is streamed once per frame.
+		struct Batch {
+			VertexBuffer     quad; // Particle quad vertices.
+			VertexBuffer instance; // Dust instance data.
+			VertexLayout   layout; // Vertex layout.
+
+			/// Generates particle quad and instance layout.
+			Batch ():
+				quad(NULL, 0, GL_STATIC_DRAW), instance(NULL, 0, GL_STREAM_DRAW), layout(GL_TRIANGLE_STRIP) {
 				// particle vertices
-				std::vector<Vertex> verts = {
+				const Vertex verts[4] = {
 					Vertex({-0.5f,  0.0f, 0.0f}, Textures::Mask::white.coords[0]),
 					Vertex({ 0.0f, -0.5f, 0.0f}, Textures::Mask::white.coords[1]),
 					Vertex({ 0.0f, +0.5f, 0.0f}, Textures::Mask::white.coords[2]),
 					Vertex({+0.5f,  0.0f, 0.0f}, Textures::Mask::white.coords[3])
 				};
+				quad.reset((const float*)verts, sizeof(verts));
+				layout.count = 4;
+
+				// link vertex attributes
+				layout.bind();
+				quad.bind();
+				layout.link(0, 3, GL_FLOAT, 8 * sizeof(float), 0 * sizeof(float));
+				layout.link(1, 3, GL_FLOAT, 8 * sizeof(float), 3 * sizeof(float));
+				layout.link(2, 2, GL_FLOAT, 8 * sizeof(float), 6 * sizeof(float));
+
+				// link instance attributes
+				instance.bind();
+				layout.link(3, 4, GL_FLOAT, sizeof(Instance), offsetof(Instance, pos));
+				glVertexAttribIPointer(4, 2, GL_UNSIGNED_BYTE, sizeof(Instance), (void*)offsetof(Instance, off));
+				glEnableVertexAttribArray(4);
+				glVertexAttribDivisor(3, 1);
+				glVertexAttribDivisor(4, 1);
+				layout.unbind();
+				instance.unbind();
+			};
+
+			/// Draws dust instances.
+			/// @param data Instance data.
+			/// @param count Instance count.
+			/// @return Drawn vertex count.
+			size_t draw(const Instance* data, size_t count) {
+				static GLint uf_object = Shaders::dst.object;
+				static GLint uf_timer = Shaders::dst.at("timer");
+				Shaders::dst.use();
+
+				// update shared particle transform & rainbow time
+				glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+				glUniformMatrix4fv(uf_object, 1, GL_FALSE, glm::value_ptr(rotation));
+				glUniform1ui(uf_timer, Timers::fast.value());
+
+				// stream instance data
+				instance.reset((const float*)data, sizeof(Instance) * count);
 
-				// generate particle object
-				object = new Object;
-				object->set(verts);
-				object->indexQuads();
-				object->update();
-				object->rotZ = glm::radians(45.0f);
+				// draw all instances
+				layout.bind();
+				glDrawArraysInstanced(layout.prim, 0, layout.count, count);
+				layout.unbind();
+				return layout.count * count;
 			};
-			return *object;
+		};
+
+		/// Shared dust renderer.
+		static Batch* batch = NULL;
+
+		/// Unloads particle model.
+		void unload() {
+			if (batch)
+				delete batch;
+		};
+
+		/// Returns dust renderer.
+		Batch& renderer() {
+			if (batch == NULL)
+				batch = new Batch;
+			return *batch;
 		};
 
 		/// Acceleration controlled value.
@@ -68,57 +126,147 @@ namespace Models {
 			Accel<float>     dim; /// Dust size.
 			uint8_t          off; /// Dust rainbow offset.
 			uint8_t         mode; /// Dust rainbow mode.
+		};
 
-			/// Updates dust's state.
-			/// @param delta Time elapsed since last frame.
-			void update(float delta) {
-				pos.update(delta);
-				dim.update(delta);
+		/// Integrates acceleration controlled values.
+		/// @param s Value positions.
+		/// @param v Value velocities.
+		/// @param a Value accelerations.
+		/// @param count Value count.
+		/// @param delta Time elapsed since last frame.
+		/// @note Arrays must not overlap, so the loop can be vectorized.
+		void integrate(float* __restrict s, float* __restrict v, const float* __restrict a, size_t count, float delta) {
+			for (size_t i = 0; i < count; i++) {
+				v[i] += a[i] * delta;
+				s[i] += v[i] * delta;
 			};
 		};
 
 		/// Collection of dust particles.
+		/// @note Particles are kept in a fixed capacity pool of separate arrays, so integration streams over plain floats.
+		/// @note Dead particles are recycled by moving the last live particle into their slot.
+		/// @note Copies of the system are empty, since particles are only presented and never simulated.
 		class System {
+			public:
+			/// Maximum live particle count.
+			static constexpr size_t capacity = 4096;
+
 			protected:
-			/// Dust particle list.
-			std::vector<Dust> dustlist;
+			std::vector<glm::vec3> pos; // Dust positions.
+			std::vector<glm::vec3> vel; // Dust velocities.
+			std::vector<glm::vec3> acc; // Dust accelerations.
+			std::vector<float>     dim; // Dust sizes.
+			std::vector<float>    dimv; // Dust size velocities.
+			std::vector<float>    dima; // Dust size accelerations.
+			std::vector<uint8_t>   off; // Dust rainbow offsets.
+			std::vector<uint8_t>  mode; // Dust rainbow modes.
+
+			/// Instance data staging buffer.
+			mutable std::vector<Instance> staging;
+
+			/// Live particle count.
+			size_t count = 0;
+
+			/// Moves a particle into another slot.
+			/// @param dst Destination slot.
+			/// @param src Source slot.
+			void move(size_t dst, size_t src) {
+				pos[dst] = pos[src];
+				vel[dst] = vel[src];
+				acc[dst] = acc[src];
+				dim[dst] = dim[src];
+				dimv[dst] = dimv[src];
+				dima[dst] = dima[src];
+				off[dst] = off[src];
+				mode[dst] = mode[src];
+			};
 
 			public:
+			/// Empty system constructor.
+			System () {};
+
+			/// Copy constructor.
+			/// @note Copy will ignore particles.
+			System (const System& system) {};
+
+			/// Copy assignment.
+			/// @note Copy will ignore particles, so assigned system keeps its own ones.
+			System& operator=(const System& system) { return *this; };
+
+			/// Returns live particle count.
+			size_t size() const { return count; };
+
 			/// Updates all dust parameters.
 			/// @param delta Time elapsed since last frame.
 			void update(float delta) {
-				/// Update all particles.
-				for (Dust& dust : dustlist) {
-					if (dust.dim.s > 0)
-						dust.update(delta);
+				if (count == 0) return;
+
+				// integrate particle motion
+				integrate(glm::value_ptr(pos[0]), glm::value_ptr(vel[0]), glm::value_ptr(acc[0]), count * 3, delta);
+				integrate(dim.data(), dimv.data(), dima.data(), count, delta);
+
+				// recycle dead particles
+				for (size_t i = 0; i < count;) {
+					if (dim[i] > 0) { i++; continue; };
+					move(i, --count);
 				};
 			};
 
 			/// Adds a dust particle into the system.
-			void add(Dust dust) { dustlist.push_back(dust); };
+			/// @param dust Dust particle.
+			/// @note Particle is dropped if the pool is full.
+			void add(const Dust& dust) {
+				if (count == capacity) return;
+
+				// allocate pool on first use
+				if (pos.empty()) {
+					pos.resize(capacity);
+					vel.resize(capacity);
+					acc.resize(capacity);
+					dim.resize(capacity);
+					dimv.resize(capacity);
+					dima.resize(capacity);
+					off.resize(capacity);
+					mode.resize(capacity);
+				};
+
+				// store particle
+				pos[count] = dust.pos.s;
+				vel[count] = dust.pos.v;
+				acc[count] = dust.pos.a;
+				dim[count] = dust.dim.s;
+				dimv[count] = dust.dim.v;
+				dima[count] = dust.dim.a;
+				off[count] = dust.off;
+				mode[count] = dust.mode;
+				count++;
+			};
 
 			/// Draws dust particles.
 			/// @return Drawn vertex count.
+			/// @note All particles are drawn with a single instanced draw call.
 			size_t draw() const {
-				Assets::mask.bind();
-				size_t vertcount = 0;
-				for (const Dust& dust : dustlist) {
-					// check if particle is active
-					if (dust.dim.s <= 0) continue;
-
-					// set model parameters
-					model().pos = dust.pos.s;
-					model().scale = glm::vec3(dust.dim.s);
-					model().color = Rainbow::dust(dust.off, dust.mode);
-
-					// draw model
-					vertcount += model().draw(Shaders::tex);
-				};
-				return vertcount;
+				if (count == 0) return 0;
+
+				// gather instance data
+				staging.resize(count);
+				for (size_t i = 0; i < count; i++)
+					staging[i] = { pos[i], dim[i], off[i], mode[i] };
+
+				// queue instances
+				RenderQueue::submit(RenderQueue::Color, RenderQueue::Blend, Shaders::dst, Assets::mask, flush, this);
+				return renderer().layout.count * count;
+			};
+
+			/// Draws staged dust particles.
+			/// @param data Particle system.
+			static void flush(const void* data) {
+				const System& system = *(const System*)data;
+				renderer().draw(system.staging.data(), system.count);
 			};
 
 			/// Clears all particles.
-			void clear() { dustlist.clear(); };
+			void clear() { count = 0; };
 		};
 	};
 };
\ No newline at end of file
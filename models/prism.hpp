@@ -10,6 +10,17 @@ namespace Models {
 		/// Prism shadow height.
 		const float shadowZ = -2.0f;
 
+		/// Sets cube face weights for rainbow face coloring.
+		/// @param verts Cube vertices in `faces` order.
+		void weigh(Vertex* verts) {
+			// X-axis, Z-axis & Y-axis side weights
+			static const glm::vec3 weights[3] { { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } };
+			for (GLuint f = 0; f < 6; f++) {
+				for (GLuint i = 0; i < 4; i++)
+					verts[f * 4 + i].setCol(weights[f / 2]);
+			};
+		};
+
 		/// Generates a prism.
 		/// @param object Prism model.
 		/// @param shadow Prism shadow model.
@@ -25,6 +36,7 @@ namespace Models {
 				for (GLuint i = 0; i < 4; i++)
 					buffer[f * 4 + i] = Vertex(vertID(min, max, faces[f][i]), Textures::Mask::white.coords[i]);
 			};
+			weigh(buffer);
 
 			// update geometry
 			object.set(buffer, lengthof(buffer));
@@ -33,35 +45,5 @@ namespace Models {
 			// generate shadow
 			Shadow::generate(shadow, min, max, shadowZ, false);
 		};
-
-		/// Sets cube X-axis sides' color.
-		/// @param object Cube model object.
-		/// @param color Cube face color.
-		void colorX(Object& object, glm::vec3 color) {
-			for (GLuint f = 0; f < 2; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setCol(color);
-			};
-		};
-
-		/// Sets cube Y-axis sides' color.
-		/// @param object Cube model object.
-		/// @param color Cube face color.
-		void colorY(Object& object, glm::vec3 color) {
-			for (GLuint f = 4; f < 6; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setCol(color);
-			};
-		};
-
-		/// Sets cube Z-axis sides' color.
-		/// @param object Cube model object.
-		/// @param color Cube face color.
-		void colorZ(Object& object, glm::vec3 color) {
-			for (GLuint f = 2; f < 4; f++) {
-				for (GLuint i = 0; i < 4; i++)
-					object.vertices()[f * 4 + i].setCol(color);
-			};
-		};
 	};
 };
\ No newline at end of file
@@ -14,16 +14,21 @@ namespace Models {
 			const float size = 0.5f;
 
 			// helper vertices
+			// color weights select between two rainbow colors
 			Vertex buffer[4] {
-				Vertex({-size, offset * 0.5f - 0.5f, -size}, Textures::Mask::resizer.coords[0]),
-				Vertex({-size, offset * 0.5f - 0.5f,  size}, Textures::Mask::resizer.coords[1]),
-				Vertex({ size, offset * 0.5f - 0.5f, -size}, Textures::Mask::resizer.coords[2]),
-				Vertex({ size, offset * 0.5f - 0.5f,  size}, Textures::Mask::resizer.coords[3]),
+				Vertex({-size, offset * 0.5f - 0.5f, -size}, {1.0f, 0.0f, 0.0f}, Textures::Mask::resizer.coords[0]),
+				Vertex({-size, offset * 0.5f - 0.5f,  size}, {1.0f, 0.0f, 0.0f}, Textures::Mask::resizer.coords[1]),
+				Vertex({ size, offset * 0.5f - 0.5f, -size}, {0.0f, 1.0f, 0.0f}, Textures::Mask::resizer.coords[2]),
+				Vertex({ size, offset * 0.5f - 0.5f,  size}, {0.0f, 1.0f, 0.0f}, Textures::Mask::resizer.coords[3]),
 			};
 
 			// update geometry
 			object.set(buffer, lengthof(buffer));
 			object.indexQuads();
+
+			// set up rainbow colors
+			object.hue.rows = glm::ivec3(1);
+			object.hue.shift = glm::uvec3(0x00, 0xF8, 0x00);
 		};
 
 		/// Animates a resizer model (inward resizing).
@@ -31,16 +36,8 @@ namespace Models {
 		void animateIn(Object& object) {
 			uint8_t timer = Timers::mid.value();
 
-			// get resizer colors
-			glm::vec3 colorA = Rainbow::resizerA();
-			glm::vec3 colorB = Rainbow::resizerB();
-
 			// update resizer colors
-			object.vertices()[0].col = colorA;
-			object.vertices()[1].col = colorA;
-			object.vertices()[2].col = colorB;
-			object.vertices()[3].col = colorB;
-			object.update();
+			object.hue.timer = timer;
 
 			// update resizer alpha
 			if (timer < 0xC0)
@@ -73,16 +70,8 @@ namespace Models {
 		void animateOut(Object& object) {
 			uint8_t timer = Timers::mid.value();
 
-			// get resizer colors
-			glm::vec3 colorA = Rainbow::resizerA();
-			glm::vec3 colorB = Rainbow::resizerB();
-
 			// update resizer colors
-			object.vertices()[0].col = colorA;
-			object.vertices()[1].col = colorA;
-			object.vertices()[2].col = colorB;
-			object.vertices()[3].col = colorB;
-			object.update();
+			object.hue.timer = timer;
 
 			// update resizer alpha
 			if (timer < 0xC0)
@@ -91,8 +91,8 @@ namespace Models {
 			};
 
 			// send color data to background shader
-			static GLuint lpos = glGetUniformLocation(Shaders::bgs.ID, "light");
-			static GLuint dpos = glGetUniformLocation(Shaders::bgs.ID, "dark");
+			static GLint lpos = Shaders::bgs.at("light");
+			static GLint dpos = Shaders::bgs.at("dark");
 			Shaders::bgs.use();
 			glUniform3fv(lpos, 1, glm::value_ptr(state.cur.light));
 			glUniform3fv(dpos, 1, glm::value_ptr(state.cur.dark));
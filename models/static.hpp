@@ -5,6 +5,7 @@ namespace Models {
 	/// Terrain modeling.
 	namespace Terrain {
 		// import terrain texture types
+		using Textures::TexMap;
 		using Textures::Terrain::Sides;
 		using Textures::Terrain::TexLevel;
 
@@ -68,5 +69,83 @@ namespace Models {
 				verts.insert(verts.end(), buffer, buffer + 4);
 			};
 		};
+
+		/// Terrain tile slots of a theme shade level.
+		enum Slot {
+			Surface = 0, // Checker pattern surfaces.
+			ColumnX = 2, // Full & half block X-axis sides.
+			ColumnZ = 4, // Full & half block Z-axis sides.
+			Floor   = 6, // Full & half block floors.
+			Slots   = 8
+		};
+
+		/// Terrain tile count.
+		const size_t tileCount = 4 * 6 * Slots;
+		/// Maximal texture repeat count of a terrain quad.
+		const int maxRepeats = 16;
+
+		/// Returns terrain tile index.
+		/// @param theme Block theme.
+		/// @param shade Block shading.
+		/// @param slot Tile slot.
+		/// @param half Whether the block is a half block.
+		GLint tile(Theme theme, uint8_t shade, Slot slot, bool half) {
+			return (theme * 6 + shade) * Slots + slot + half;
+		};
+
+		/// Sends terrain tile rectangles to a shader.
+		/// @param shader Terrain shader program.
+		void sendTiles(const Shader& shader) {
+			glm::vec4 rects[tileCount];
+			for (size_t i = 0; i < tileCount; i++) {
+				const TexLevel& level = Textures::Terrain::texMaps[i / Slots / 6][i / Slots % 6];
+				const TexMap* maps[Slots] {
+					&level.surface[0], &level.surface[1],
+					&level.columnX[0], &level.columnX[1],
+					&level.columnZ[0], &level.columnZ[1],
+					&level.floor  [0], &level.floor  [1]
+				};
+				const TexMap& map = *maps[i % Slots];
+				rects[i] = glm::vec4(map.coords[2].x, map.coords[2].y, map.coords[1].x, map.coords[1].y);
+			};
+			shader.use();
+			glUniform4fv(shader.at("tiles"), tileCount, glm::value_ptr(rects[0]));
+		};
+
+		/// Generates a terrain face quad.
+		/// @param verts Output vertices.
+		/// @param face Face index in `faces` table.
+		/// @param min Covered volume minimum coordinates.
+		/// @param max Covered volume maximum coordinates.
+		/// @param tile Face tile index.
+		/// @param pattern Checker pattern of covered block at `min` corner (-1 if face has no pattern).
+		/// @param reps Covered block count along each axis.
+		/// @note Face texture is repeated once per covered block.
+		/// @note Tile data is normalized to fit packed vertices:
+		/// color stores `(tile, pattern + 1) / 255` and UV stores repeats divided by `maxRepeats`.
+		void quad(std::vector<Vertex>& verts, GLuint face, glm::vec3 min, glm::vec3 max, GLint tile, GLint pattern, glm::vec3 reps) {
+			// texture corners of face vertices
+			static const glm::vec2 corners[4] { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 0.0f, 0.0f }, { 1.0f, 0.0f } };
+
+			// get repeat count along face texture axes
+			// vertex ID bits select Z, Y & X axes from lowest
+			static const int axes[5] { -1, 2, 1, -1, 0 };
+			glm::vec2 size = glm::vec2(
+				reps[axes[faces[face][0] ^ faces[face][1]]],
+				reps[axes[faces[face][0] ^ faces[face][2]]]
+			);
+
+			// move checker pattern to block at texture origin
+			if (pattern >= 0) {
+				GLuint origin = faces[face][2];
+				if (origin & 4) pattern ^= ((int)reps.x - 1) & 1;
+				if (origin & 2) pattern ^= ((int)reps.y - 1) & 1;
+				if (origin & 1) pattern ^= ((int)reps.z - 1) & 1;
+			};
+
+			// generate vertices
+			for (GLuint i = 0; i < 4; i++)
+				verts.push_back(Vertex(vertID(min, max, faces[face][i]), glm::vec3(tile, pattern + 1, 0.0f) / 255.0f, corners[i] * size / (float)maxRepeats));
+		};
 	};
 };
\ No newline at end of file
@@ -60,6 +60,7 @@ namespace Music {
 		return table[(theme >= 0 && theme < Space) ? theme : Space];
 	};
 
+	#ifndef HEADLESS
 	/// Music player.
 	sf::Music bgm;
 	/// Whether the music is fading.
@@ -101,4 +102,5 @@ namespace Music {
 
 	/// Stops music.
 	void stop() { bgm.stop(); };
+	#endif
 };
\ No newline at end of file
@@ -10,25 +10,72 @@ class Object {
 
 	/// Vertex buffer object.
 	VertexBuffer buffer;
+	/// Vertex index buffer object.
+	IndexBuffer elements;
 	/// Vertex layout object.
 	VertexLayout layout;
+	/// Whether vertices are uploaded in packed format.
+	bool packed;
+	/// Packed vertex upload storage.
+	/// @note Kept between uploads, so repeated updates do not allocate.
+	mutable std::vector<PackedVertex> packs;
 
 	/// Generates object layout.
 	void genLayout() {
-		layout.link(0, 3, GL_FLOAT, 8 * sizeof(float), 0 * sizeof(float));
-		layout.link(1, 3, GL_FLOAT, 8 * sizeof(float), 3 * sizeof(float));
-		layout.link(2, 2, GL_FLOAT, 8 * sizeof(float), 6 * sizeof(float));
+		if (packed) {
+			layout.link(0, 3, GL_SHORT         , sizeof(PackedVertex), offsetof(PackedVertex, pos));
+			layout.link(1, 3, GL_UNSIGNED_BYTE , sizeof(PackedVertex), offsetof(PackedVertex, col), GL_TRUE);
+			layout.link(2, 2, GL_UNSIGNED_SHORT, sizeof(PackedVertex), offsetof(PackedVertex, tex), GL_TRUE);
+		} else {
+			layout.link(0, 3, GL_FLOAT, 8 * sizeof(float), 0 * sizeof(float));
+			layout.link(1, 3, GL_FLOAT, 8 * sizeof(float), 3 * sizeof(float));
+			layout.link(2, 2, GL_FLOAT, 8 * sizeof(float), 6 * sizeof(float));
+		};
 	};
 
-	/// Generates vertex data.
-	/// @param vert Vertex.
-	/// @param floats Data buffer.
-	static void genVertex(const Vertex& vert, std::vector<float>& floats) {
-		const float* repr = (const float*)&vert;
-		floats.insert(floats.end(), repr, repr + sizeof(repr));
+	/// Uploads vertex indices into the index buffer.
+	void upload() {
+		layout.bind();
+		elements.reset(indices.data(), indices.size());
+		layout.unbind();
+	};
+
+	/// Sends object uniforms to a shader.
+	/// @param shader Shader program.
+	void uniform(const Shader& shader) const {
+		shader.use();
+
+		// update object transform matrix
+		// packed positions are scaled back from fixed point steps
+		glm::mat4 transform = matrix();
+		if (packed) transform = glm::scale(transform, glm::vec3(PackedVertex::unit));
+		glUniformMatrix4fv(shader.object, 1, GL_FALSE, glm::value_ptr(transform));
+
+		// update object color & alpha
+		glUniform3fv(shader.color, 1, glm::value_ptr(color));
+		glUniform1f(shader.alpha, alpha);
+
+		// update rainbow face coloring
+		glUniform3iv(shader.hueRows, 1, glm::value_ptr(hue.rows));
+		if (hue.rows.x < 0) return;
+		glUniform3uiv(shader.hueShift, 1, glm::value_ptr(hue.shift));
+		glUniform3iv(shader.hueTo, 1, glm::value_ptr(hue.to));
+		glUniform1f(shader.hueMix, hue.mix);
+		glUniform1ui(shader.timer, hue.timer);
 	};
 
 	public:
+	/// Rainbow face coloring settings.
+	/// @note While enabled, vertex colors are used as X, Y & Z face weights.
+	/// @note Face colors are fetched from the rainbow table on GPU, so animating them needs no vertex updates.
+	struct Hue {
+		glm::ivec3  rows = glm::ivec3(-1);      /// Rainbow table rows of X, Y & Z faces (-1 if disabled).
+		glm::uvec3 shift = glm::uvec3(0);       /// Rainbow timer offsets of X, Y & Z faces.
+		glm::ivec3    to = glm::ivec3(0, 1, 2); /// Gradient target face of X, Y & Z faces.
+		float        mix = 0.0f;                /// Gradient progress.
+		GLuint     timer = 0;                   /// Rainbow timer value.
+	};
+
 	/// Object position.
 	glm::vec3 pos;
 	/// Object rotation around "up" axis.
@@ -41,10 +88,15 @@ class Object {
 	float alpha;
 	/// Custom object vertex index count.
 	GLuint idCount;
+	/// Object rainbow face coloring.
+	Hue hue;
 
 	/// Default empty object constructor.
-	Object (GLenum primitive = GL_TRIANGLES):
-		buffer((const float*)verts.data(), 0, GL_DYNAMIC_DRAW), layout(primitive),
+	/// @param primitive Vertex connection type.
+	/// @param packed Whether vertices are uploaded in packed format.
+	/// @note Packed models must satisfy `PackedVertex` range limits.
+	Object (GLenum primitive = GL_TRIANGLES, bool packed = false):
+		buffer((const float*)verts.data(), 0, GL_DYNAMIC_DRAW), layout(primitive), packed(packed),
 		pos(glm::vec3(0.0f)), rotZ(0.0f), scale(glm::vec3(1.0f)), color(glm::vec3(1.0f)), alpha(1.0f),
 		idCount(0) {
 		layout.bind();
@@ -58,7 +110,12 @@ class Object {
 	/// @param count Vertex count.
 	void set(const Vertex* verts, size_t count) {
 		// update vertices
-		buffer.reset((const float*)verts, sizeof(Vertex) * count);
+		if (packed) {
+			packs.assign(verts, verts + count);
+			buffer.reset((const float*)packs.data(), sizeof(PackedVertex) * count);
+		} else {
+			buffer.reset((const float*)verts, sizeof(Vertex) * count);
+		};
 		layout.count = count;
 
 		// copy data into local storage
@@ -73,6 +130,7 @@ class Object {
 	/// @param count Index count.
 	void index(const GLuint* indices, size_t count) {
 		this->indices = std::vector<GLuint>(indices, indices + count);
+		upload();
 	};
 
 	/// Updates vertex indices.
@@ -103,6 +161,7 @@ class Object {
 			GLuint i = q * 4;
 			pushQuad(indices, i, i + 1, i + 2, i + 3);
 		};
+		upload();
 	};
 
 	/// Generate vertex index table for triangles.
@@ -122,6 +181,7 @@ class Object {
 		// generate indices
 		for (GLuint q = 0; q < quad_count * 3; q++)
 			indices.push_back(q);
+		upload();
 	};
 
 	/// Pushes a quad into index array.
@@ -146,11 +206,14 @@ class Object {
 	const std::vector<Vertex>& vertlist() const { return verts; };
 
 	/// Updates vertices from vertex buffer.
+	/// @note Float vertices are uploaded directly from local storage.
 	void update() const {
-		std::vector<float> floats;
-		for (const Vertex& vert : verts)
-			genVertex(vert, floats);
-		buffer.sub(floats.data());
+		if (packed) {
+			packs.assign(verts.begin(), verts.end());
+			buffer.stream((const float*)packs.data());
+		} else {
+			buffer.stream((const float*)verts.data());
+		};
 	};
 
 	/// Generates a model matrix.
@@ -162,22 +225,38 @@ class Object {
 		return transform;
 	};
 
+	/// Attaches a per-instance offset buffer.
+	/// @param offsets Instance offset buffer.
+	/// @note Offsets are read as `vec3` at layout location 3.
+	void instance(const VertexBuffer& offsets) {
+		layout.bind();
+		offsets.bind();
+		layout.link(3, 3, GL_FLOAT, sizeof(glm::vec3), 0);
+		glVertexAttribDivisor(3, 1);
+		layout.unbind();
+	};
+
+	/// Returns vertex layout ID.
+	GLuint mesh() const { return layout.ID; };
+
+	/// Returns drawn index count.
+	size_t count() const { return idCount == 0 ? elements.count : idCount; };
+
 	/// Draws object.
 	/// @param Shader program.
 	/// @return Drawn vertex count.
 	size_t draw(const Shader& shader) const {
-		shader.use();
-
-		// update object transform matrix
-		glUniformMatrix4fv(glGetUniformLocation(shader.ID, "object"), 1, GL_FALSE, glm::value_ptr(matrix()));
-
-		// update object color & alpha
-		glUniform3fv(glGetUniformLocation(shader.ID, "color"), 1, glm::value_ptr(color));
-		glUniform1f(glGetUniformLocation(shader.ID, "alpha"), alpha);
+		uniform(shader);
+		return layout.drawIndex(count());
+	};
 
-		// draw object
-		if (idCount == 0)
-			return layout.drawIndex(indices.data(), indices.size());
-		return layout.drawIndex(indices.data(), idCount);
+	/// Draws multiple object instances.
+	/// @param shader Shader program.
+	/// @param instances Instance count.
+	/// @return Drawn vertex count.
+	/// @note Instance offsets are added on top of object transform.
+	size_t drawInstances(const Shader& shader, GLsizei instances) const {
+		uniform(shader);
+		return layout.drawInstances(count(), instances);
 	};
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+/// Frame render queue.
+/// @note Draws are submitted with their render state and executed once per pass in state order,
+/// so shaders and textures are switched as rarely as possible.
+/// @note Pass state (stencil & masks) is set up by the caller between pass executions.
+namespace RenderQueue {
+	/// Render pass.
+	enum Pass: uint8_t {
+		Color , // Color pass.
+		Shadow, // Stencil shadow volume pass.
+	};
+
+	/// Draw layer within a render pass.
+	enum Layer: uint8_t {
+		Solid, // Opaque draws, sorted by state.
+		Blend, // Blended draws, drawn after solid ones in submission order.
+	};
+
+	/// Custom draw call.
+	/// @param data Call context.
+	typedef void (*Call)(const void* data);
+
+	/// Queued draw command.
+	/// @note Model transform is read from the object during execution,
+	/// so every submitted object must keep its transform until then.
+	struct Command {
+		uint64_t         key; // State sort key.
+		uint32_t         seq; // Submission index.
+		const Shader* shader; // Shader program.
+		const Tex*       tex; // Model texture (`NULL` to keep current one).
+		const Object* object; // Drawn model (`NULL` for custom calls).
+		GLsizei    instances; // Model instance count (0 for a plain draw).
+		Call            call; // Custom draw call.
+		const void*     data; // Custom draw call context.
+	};
+
+	size_t    draws = 0; // Executed commands since last counter reset.
+	size_t  shaders = 0; // Shader switches since last counter reset.
+	size_t textures = 0; // Texture switches since last counter reset.
+
+	/// Queued commands.
+	std::vector<Command> commands;
+
+	/// Resets command counters.
+	void clearCounters() {
+		draws = 0;
+		shaders = 0;
+		textures = 0;
+	};
+
+	/// Generates a command sort key.
+	/// @param pass Render pass.
+	/// @param layer Draw layer.
+	/// @param shader Shader program ID.
+	/// @param tex Texture ID.
+	/// @param mesh Vertex layout ID.
+	/// @note Key fields from highest bits are: pass, layer, shader, texture & mesh.
+	/// @note Blended commands ignore state, so they keep submission order.
+	inline uint64_t key(Pass pass, Layer layer, GLuint shader, GLuint tex, GLuint mesh) {
+		uint64_t key = (uint64_t)pass << 62 | (uint64_t)layer << 61;
+		if (layer == Blend) return key;
+		return key | (uint64_t)(shader & 0xFFF) << 44 | (uint64_t)(tex & 0xFFFF) << 28 | (mesh & 0xFFFFFFF);
+	};
+
+	/// Queues a model draw.
+	/// @param pass Render pass.
+	/// @param layer Draw layer.
+	/// @param shader Shader program.
+	/// @param tex Model texture.
+	/// @param object Drawn model.
+	/// @param instances Model instance count (0 for a plain draw).
+	/// @return Drawn vertex count.
+	size_t submit(Pass pass, Layer layer, const Shader& shader, const Tex& tex, const Object& object, GLsizei instances = 0) {
+		commands.push_back({
+			key(pass, layer, shader.ID, tex.ID, object.mesh()), (uint32_t)commands.size(),
+			&shader, &tex, &object, instances, NULL, NULL
+		});
+		return instances ? object.count() * instances : object.count();
+	};
+
+	/// Queues a custom draw call.
+	/// @param pass Render pass.
+	/// @param layer Draw layer.
+	/// @param shader Shader program used by the call.
+	/// @param tex Texture used by the call.
+	/// @param call Custom draw call.
+	/// @param data Call context.
+	void submit(Pass pass, Layer layer, const Shader& shader, const Tex& tex, Call call, const void* data) {
+		commands.push_back({
+			key(pass, layer, shader.ID, tex.ID, 0), (uint32_t)commands.size(),
+			&shader, &tex, NULL, 0, call, data
+		});
+	};
+
+	/// Executes queued commands of a render pass.
+	/// @param pass Render pass.
+	/// @note Executed commands are removed from the queue.
+	void execute(Pass pass) {
+		// order commands by state
+		std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+			return a.key != b.key ? a.key < b.key : a.seq < b.seq;
+		});
+
+		// find pass commands
+		auto first = std::find_if(commands.begin(), commands.end(), [=](const Command& cmd) { return cmd.key >> 62 == pass; });
+		auto last  = std::find_if(first, commands.end(), [=](const Command& cmd) { return cmd.key >> 62 != pass; });
+
+		// draw commands
+		const Shader* shader = NULL;
+		const Tex* tex = NULL;
+		for (auto it = first; it != last; it++) {
+			// switch state
+			if (it->shader != shader) {
+				shader = it->shader;
+				shaders++;
+			};
+			if (it->tex != tex) {
+				tex = it->tex;
+				tex->bind();
+				textures++;
+			};
+
+			// draw model
+			if (it->object == NULL)
+				it->call(it->data);
+			else if (it->instances)
+				it->object->drawInstances(*it->shader, it->instances);
+			else
+				it->object->draw(*it->shader);
+			draws++;
+		};
+		commands.erase(first, last);
+	};
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#version 330 core
+
+// vertex data layout
+layout (location = 0) in vec3 vertPos;
+layout (location = 1) in vec3 vertCol;
+layout (location = 2) in vec2 vertTex;
+
+// instance data layout
+layout (location = 3) in vec4 dustPos;
+layout (location = 4) in uvec2 dustHue;
+
+// color data layout
+out vec4 pixCol;
+out vec2 pixTex;
+
+// shared frame data
+layout (std140) uniform Frame {
+	mat4 camera;
+	uvec2 window;
+};
+
+// particle model matrix
+uniform mat4 object;
+
+// rainbow color table
+uniform sampler2D rainbow;
+uniform uint timer;
+
+/// Vertex shader code.
+void main() {
+	// calculate position
+	vec4 pos = object * vec4(vertPos, 1.0f);
+	gl_Position = camera * vec4(dustPos.xyz + pos.xyz * dustPos.w, 1.0f);
+
+	// fetch rainbow color
+	vec3 color = texelFetch(rainbow, ivec2((dustHue.x + timer) & 255u, dustHue.y), 0).rgb;
+
+	// pipe color data
+	pixCol = vec4(vertCol * color, 1.0f);
+	pixTex = vertTex;
+}
\ No newline at end of file
@@ -8,9 +8,11 @@ layout (location = 1) in vec2 vertTex;
 out vec4 pixCol;
 out vec2 pixTex;
 
-// display window size
-uniform uint winX;
-uniform uint winY;
+// shared frame data
+layout (std140) uniform Frame {
+	mat4 camera;
+	uvec2 window;
+};
 
 // model configuration
 uniform vec2 translate;
@@ -24,8 +26,8 @@ void main() {
 
 	// calculate 3D position
 	gl_Position = vec4(
-		pos.x * 2.0f / winX - 1.0f,
-		1.0f - pos.y * 2.0f / winY,
+		pos.x * 2.0f / window.x - 1.0f,
+		1.0f - pos.y * 2.0f / window.y,
 		-1.0f, 1.0f
 	);
 
@@ -5,24 +5,55 @@ layout (location = 0) in vec3 vertPos;
 layout (location = 1) in vec3 vertCol;
 layout (location = 2) in vec2 vertTex;
 
+// instance data layout
+layout (location = 3) in vec3 instPos;
+
 // color data layout
 out vec4 pixCol;
 out vec2 pixTex;
 
-// world camera matrix
-uniform mat4 camera;
+// shared frame data
+layout (std140) uniform Frame {
+	mat4 camera;
+	uvec2 window;
+};
 
 // object properties
 uniform mat4 object;
 uniform vec3 color;
 uniform float alpha;
 
+// rainbow color table
+uniform sampler2D rainbow;
+uniform uint timer;
+
+// rainbow face coloring
+// vertex colors are used as X, Y & Z face weights, if enabled
+uniform ivec3 hueRows;  // rainbow rows of faces (-1 if disabled)
+uniform uvec3 hueShift; // rainbow timer offsets of faces
+uniform ivec3 hueTo;    // gradient target faces
+uniform float hueMix;   // gradient progress
+
+/// Returns rainbow color of a face.
+/// @param face Face axis index.
+vec3 hue(int face) {
+	return texelFetch(rainbow, ivec2((timer + hueShift[face]) & 255u, hueRows[face]), 0).rgb;
+}
+
 /// Vertex shader code.
 void main() {
 	// calculate position
-	gl_Position = camera * object * vec4(vertPos, 1.0f);
+	gl_Position = camera * (object * vec4(vertPos, 1.0f) + vec4(instPos, 0.0f));
+
+	// calculate face colors
+	vec3 col = vertCol;
+	if (hueRows.x >= 0) {
+		col = vec3(0.0f);
+		for (int i = 0; i < 3; i++)
+			col += vertCol[i] * mix(hue(i), hue(hueTo[i]), hueMix);
+	}
 
 	// pipe color data
-	pixCol = vec4(vertCol * color, alpha);
+	pixCol = vec4(col * color, alpha);
 	pixTex = vertTex;
 }
\ No newline at end of file
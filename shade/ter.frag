@@ -0,0 +1,27 @@
+#version 330 core
+
+// tile data layout
+in vec2 pixRep;
+flat in int pixTile;
+flat in int pixPattern;
+
+// fragment color output
+layout (location = 0) out vec4 pixel;
+
+// terrain texture
+uniform sampler2D tex;
+
+// terrain tile rectangles
+uniform vec4 tiles[192];
+
+/// Fragment shader code.
+void main() {
+	// select checker pattern tile
+	int tile = pixTile;
+	if (pixPattern >= 0)
+		tile += (pixPattern + int(floor(pixRep.x)) + int(floor(pixRep.y))) & 1;
+
+	// repeat tile over face
+	vec4 rect = tiles[tile];
+	pixel = texture(tex, mix(rect.xy, rect.zw, fract(pixRep)));
+}
\ No newline at end of file
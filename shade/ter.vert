@@ -0,0 +1,31 @@
+#version 330 core
+
+// vertex data layout
+layout (location = 0) in vec3 vertPos;
+layout (location = 1) in vec3 vertTile;
+layout (location = 2) in vec2 vertRep;
+
+// tile data layout
+out vec2 pixRep;
+flat out int pixTile;
+flat out int pixPattern;
+
+// shared frame data
+layout (std140) uniform Frame {
+	mat4 camera;
+	uvec2 window;
+};
+
+// object properties
+uniform mat4 object;
+
+/// Vertex shader code.
+void main() {
+	// calculate position
+	gl_Position = camera * object * vec4(vertPos, 1.0f);
+
+	// unpack tile data
+	pixRep = round(vertRep * 16.0f);
+	pixTile = int(round(vertTile.x * 255.0f));
+	pixPattern = int(round(vertTile.y * 255.0f)) - 1;
+}
\ No newline at end of file
@@ -1,17 +1,38 @@
+/// Shared per-frame uniform block binding point.
+const GLuint frameBinding = 0;
+
 /// Shader object.
 class Shader {
 	public:
 	GLuint ID;
 
-	/// Loads shader for further operations.
-	void use() const {
-		static GLuint last = -1;
-		if (ID != last);
-			glUseProgram(last = ID);
+	/// Active uniform locations.
+	std::unordered_map<std::string, GLint> uniforms;
+
+	GLint object = -1; // Object matrix uniform location.
+	GLint  color = -1; // Object color uniform location.
+	GLint  alpha = -1; // Object alpha uniform location.
+	GLint  timer = -1; // Rainbow timer uniform location.
+
+	GLint  hueRows = -1; // Rainbow face rows uniform location.
+	GLint hueShift = -1; // Rainbow face offsets uniform location.
+	GLint    hueTo = -1; // Gradient target faces uniform location.
+	GLint   hueMix = -1; // Gradient progress uniform location.
+
+	/// Returns uniform location.
+	/// @param name Uniform name.
+	/// @return Uniform location, or -1 if the uniform is not active.
+	/// @note Meant for setup code, draw calls should use cached locations.
+	GLint at(const char* name) const {
+		auto it = uniforms.find(name);
+		return it == uniforms.end() ? -1 : it->second;
 	};
 
+	/// Loads shader for further operations.
+	void use() const { GLState::useProgram(ID); };
+
 	/// Unloads shader.
-	void unload() { glDeleteProgram(ID); ID = 0; };
+	void unload() { GLState::dropProgram(ID); glDeleteProgram(ID); ID = 0; uniforms.clear(); };
 
 	/// Compiles shader code.
 	/// @param source Shader source code.
@@ -42,11 +63,54 @@ class Shader {
 		glLinkProgram(prog);
 		report(prog, 'p');
 
-		// return shader program object
-		return Shader { prog };
+		// create shader program object
+		Shader shader;
+		shader.ID = prog;
+		shader.reflect();
+		return shader;
 	};
 
 	private:
+	/// Caches active uniform locations.
+	/// @note Also binds shared frame uniform block.
+	void reflect() {
+		// query active uniforms
+		GLint count = 0;
+		glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+		for (GLint i = 0; i < count; i++) {
+			char name[256];
+			GLsizei len;
+			GLint size;
+			GLenum type;
+			glGetActiveUniform(ID, i, sizeof(name), &len, &size, &type, name);
+
+			// strip array suffix
+			char* br = strchr(name, '[');
+			if (br) *br = 0;
+
+			// skip block members
+			GLint loc = glGetUniformLocation(ID, name);
+			if (loc != -1) uniforms[name] = loc;
+		};
+
+		// cache object uniforms
+		object = at("object");
+		color = at("color");
+		alpha = at("alpha");
+		timer = at("timer");
+
+		// cache rainbow face coloring uniforms
+		hueRows = at("hueRows");
+		hueShift = at("hueShift");
+		hueTo = at("hueTo");
+		hueMix = at("hueMix");
+
+		// bind frame uniform block
+		GLuint block = glGetUniformBlockIndex(ID, "Frame");
+		if (block != GL_INVALID_INDEX)
+			glUniformBlockBinding(ID, block, frameBinding);
+	};
+
 	/// Reports shader status.
 	/// @param shader Shader ID.
 	/// @param type Shader type.
@@ -119,6 +183,44 @@ namespace Shaders {
 	Shader bgs;
 	/// Shadow mask shader.
 	Shader sdw;
+	/// Dust particle shader.
+	Shader dst;
+	/// Terrain shader.
+	Shader ter;
+
+	/// Shared per-frame uniform data.
+	/// @note Layout matches `Frame` std140 uniform block in shader sources.
+	struct Frame {
+		glm::mat4  camera; // Camera matrix.
+		glm::uvec2 window; // Window size.
+		glm::uvec2    pad; // Padding to std140 block size.
+	};
+
+	/// Frame uniform buffer ID.
+	GLuint frame = 0;
+
+	/// Creates frame uniform buffer.
+	void loadFrame() {
+		glGenBuffers(1, &frame);
+		glBindBuffer(GL_UNIFORM_BUFFER, frame);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(Frame), NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, frameBinding, frame);
+	};
+
+	/// Updates camera matrix for all shaders.
+	/// @param mat Camera matrix.
+	void sendCamera(const glm::mat4& mat) {
+		glBindBuffer(GL_UNIFORM_BUFFER, frame);
+		glBufferSubData(GL_UNIFORM_BUFFER, offsetof(Frame, camera), sizeof(Frame::camera), glm::value_ptr(mat));
+	};
+
+	/// Updates window size for all shaders.
+	/// @param size Window size.
+	void sendWindow(glm::uvec2 size) {
+		glBindBuffer(GL_UNIFORM_BUFFER, frame);
+		glBufferSubData(GL_UNIFORM_BUFFER, offsetof(Frame, window), sizeof(Frame::window), glm::value_ptr(size));
+	};
 
 	/// Reads contents of file.
 	/// @param path File path.
@@ -155,6 +257,9 @@ namespace Shaders {
 	void load() {
 		Log::out.separator("Shaders");
 
+		// create shared uniform buffer
+		loadFrame();
+
 		// shader file data
 		struct filedata_t {
 			const char* path;
@@ -167,6 +272,9 @@ namespace Shaders {
 			{ "shade/gui.vert", 'v' }, // 3
 			{ "shade/bgs.vert", 'v' }, // 4
 			{ "shade/bgs.frag", 'f' }, // 5
+			{ "shade/dst.vert", 'v' }, // 6
+			{ "shade/ter.vert", 'v' }, // 7
+			{ "shade/ter.frag", 'f' }, // 8
 		};
 		const size_t N = lengthof(shaders);
 
@@ -181,7 +289,9 @@ namespace Shaders {
 			{ "texture shader"   , &tex, 0, 2 },
 			{ "GUI shader"       , &gui, 3, 2 },
 			{ "background shader", &bgs, 4, 5 },
-			{ "shadow shader"    , &sdw, 4, 1 }
+			{ "shadow shader"    , &sdw, 4, 1 },
+			{ "dust shader"      , &dst, 6, 2 },
+			{ "terrain shader"   , &ter, 7, 8 }
 		};
 
 		// load code
@@ -221,5 +331,9 @@ namespace Shaders {
 		gui.unload();
 		bgs.unload();
 		sdw.unload();
+		dst.unload();
+		ter.unload();
+		glDeleteBuffers(1, &frame);
+		frame = 0;
 	};
 };
\ No newline at end of file
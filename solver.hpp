@@ -0,0 +1,378 @@
+#pragma once
+
+/// Level solver namespace.
+namespace Solver {
+	/// Cube decision enumeration.
+	enum Action : uint8_t {
+		RollE, // Roll east.
+		RollW, // Roll west.
+		RollN, // Roll north.
+		RollS, // Roll south.
+		Wait , // Wait without input.
+	};
+
+	/// Solver result object.
+	struct Result {
+		size_t   expanded; // Simulated decision count.
+		size_t     unique; // Unique state count.
+		uint16_t     pttl; // Total prism count.
+		uint16_t    reach; // Reachable prism count.
+		bool         exit; // Whether the exit is reachable.
+		size_t      ticks; // Fastest exit path tick count.
+		Bytes::Path  path; // Fastest exit path input.
+		float        wall; // Elapsed real time in seconds.
+	};
+
+	/// Compact hash map of state keys to their fastest ticks.
+	/// @note Keys are stored in an open addressing table, where zero marks empty slots.
+	class Visited {
+		private:
+		/// Key slots.
+		std::vector<uint64_t> slots;
+		/// Fastest ticks of each key slot.
+		std::vector<size_t> ticks;
+		/// Stored key count.
+		size_t count = 0;
+
+		/// Finds the slot of a key, or the empty slot it would be stored in.
+		/// @param key Nonzero state key.
+		size_t find(uint64_t key) const {
+			size_t mask = slots.size() - 1;
+			for (size_t i = key & mask;; i = (i + 1) & mask)
+				if (slots[i] == key || slots[i] == 0) return i;
+		};
+
+		public:
+		/// Hash map constructor.
+		Visited (): slots(1 << 16, 0), ticks(1 << 16, 0) {};
+
+		/// Returns stored key count.
+		size_t size() const { return count; };
+
+		/// Returns fastest ticks a key was reached in, or `-1` if it was not.
+		/// @param key State key.
+		size_t fastest(uint64_t key) const {
+			key |= key == 0;
+			size_t i = find(key);
+			return slots[i] == key ? ticks[i] : -1ULL;
+		};
+
+		/// Inserts a key.
+		/// @param key State key.
+		/// @param time Ticks the state was reached in.
+		/// @return Whether the key was new or reached faster than before.
+		bool insert(uint64_t key, size_t time) {
+			key |= key == 0;
+
+			// grow at half load
+			if ((count + 1) * 2 > slots.size()) {
+				std::vector<uint64_t> oldSlots(slots.size() * 2, 0);
+				std::vector<size_t> oldTicks(ticks.size() * 2, 0);
+				oldSlots.swap(slots);
+				oldTicks.swap(ticks);
+				for (size_t i = 0; i < oldSlots.size(); i++) {
+					if (oldSlots[i] == 0) continue;
+					size_t j = find(oldSlots[i]);
+					slots[j] = oldSlots[i];
+					ticks[j] = oldTicks[i];
+				};
+			};
+
+			// store key
+			size_t i = find(key);
+			if (slots[i] == key) {
+				if (time >= ticks[i]) return false;
+				ticks[i] = time;
+				return true;
+			};
+			slots[i] = key;
+			ticks[i] = time;
+			count++;
+			return true;
+		};
+	};
+
+	/// Level reachability solver.
+	/// @note A* search over cube decisions, ordered by ticks since level start plus distance to the exit.
+	/// @note Frontier states are expanded in parallel batches, with one level copy per worker.
+	class Solver {
+		private:
+		/// Search node object.
+		struct Node {
+			std::vector<uint8_t> data; // Level snapshot (freed after expansion).
+			size_t             parent; // Parent node index.
+			size_t              ticks; // Ticks since level start.
+			Action             action; // Decision leading to the node.
+			uint64_t              key; // State key.
+		};
+
+		/// Expanded decision object.
+		struct Child {
+			std::vector<uint8_t>   data; // Level snapshot.
+			std::vector<uint16_t>  left; // Remaining prism indices.
+			uint64_t                key; // State key.
+			size_t                ticks; // Ticks since level start.
+			size_t                 cost; // Estimated exit path ticks.
+			bool                  valid = false; // Whether the cube survived.
+			bool                   exit = false; // Whether the cube reached the exit.
+		};
+
+		/// Worker levels.
+		std::deque<Level::Level> levels;
+		/// Worker thread pool.
+		Headless::Pool pool;
+		/// Search nodes.
+		std::vector<Node> nodes;
+		/// Visited state keys.
+		Visited visited;
+
+		/// Returns remaining prism indices of a level.
+		/// @param level Level object.
+		static std::vector<uint16_t> prisms(const Level::Level& level) {
+			std::vector<uint16_t> left;
+			for (const Level::Prism& prism : level.state.prisms)
+				left.push_back(prism.root - level.root.prisms.data());
+			return left;
+		};
+
+		/// Returns a coarse key of level state.
+		/// @param level Level object.
+		/// @note Continuous values are bucketed, so states differing only in timing details merge.
+		/// @note Platform timers are bucketed by wait decision length, so waiting for a platform leads to new states.
+		/// @note Merged states keep the fastest ticks, so slower duplicates are dropped even if expanded first.
+		uint64_t key(Level::Level& level) const {
+			Level::Snapshot snap(Level::Snapshot::Hash);
+			Level::Cube& player = level.getPlayer();
+			sf::Vector3i pos = player.minipos().int3();
+			int energy = (int)(player.energy * 8fx);
+			int sx = (int)(player.speed.x * 256fx), sy = (int)(player.speed.y * 256fx);
+			snap(pos)(player.settings.mini)(energy)(sx)(sy);
+
+			// hash discrete element states
+			for (uint16_t idx : prisms(level)) snap(idx);
+			Level::State& state = level.state;
+			for (size_t i = 0; i < state.movingPlats.size(); i++) {
+				uint32_t phase = state.movingPlats.time[i] / (std::max<size_t>(wait, 1) * Level::stepTicks);
+				snap(state.movingPlats.waypoint[i])(state.movingPlats.active[i])(phase);
+			};
+			for (size_t i = 0; i < state.fallingPlats.size(); i++) snap(state.fallingPlats.state[i]);
+			for (size_t i = 0; i < state.buttons.size(); i++) snap(state.buttons.state[i]);
+			for (Level::Checkpoint& check : state.checks) snap(check.active);
+			for (Level::DarkCube& cube : state.darkcubes) snap(cube.active);
+			return snap.hash();
+		};
+
+		/// Estimates ticks left to reach the exit.
+		/// @param level Level object.
+		/// @note Only horizontal distance is charged, since falls cover tiles in far fewer steps than rolls.
+		/// @note The estimate is admissible as long as `speed` does not exceed ticks of the fastest roll.
+		size_t estimate(Level::Level& level) const {
+			vec3x diff = level.root.exit - level.getPlayer().tile;
+			fix dist = diff.x.abs() + diff.y.abs();
+			return (size_t)(float)(dist * fix((float)speed));
+		};
+
+		/// Simulates a decision.
+		/// @param node Source node.
+		/// @param action Cube decision.
+		/// @param level Worker level.
+		/// @param child Expanded decision.
+		void expand(Node& node, Action action, Level::Level& level, Child& child) {
+			level.load(node.data);
+			size_t deaths = level.deaths;
+
+			// get held keys
+			Level::CubeInput input;
+			input.east = action == RollE;
+			input.west = action == RollW;
+			input.north = action == RollN;
+			input.south = action == RollS;
+
+			// simulate until next decision
+			for (size_t ticks = 1;; ticks++) {
+				level.getPlayer().keys.set(input);
+				level.update(Timers::step);
+
+				// check cube state
+				Level::Cube& player = level.getPlayer();
+				if (level.deaths != deaths || player.act == Level::Cube::Crush) return;
+				if (level.exitReq) break;
+				if (player.act == Level::Cube::Idle) {
+					if (action != Wait && ticks == 1) return;
+					if (action != Wait || ticks >= wait) break;
+				};
+				if (ticks >= settle) return;
+			};
+			level.getPlayer().keys.set(Level::CubeInput());
+
+			// store state
+			level.save(child.data);
+			child.left = prisms(level);
+			child.key = key(level);
+			child.ticks = level.steps;
+			child.cost = child.ticks + estimate(level);
+			child.exit = level.exitReq;
+			child.valid = true;
+		};
+
+		/// Builds input path to a node.
+		/// @param idx Node index.
+		/// @note Events are placed half a tick before their step, so float time drain never shifts them.
+		Bytes::Path path(size_t idx) const {
+			// collect key presses and releases
+			struct Press { size_t tick; Action action; bool key; };
+			std::deque<Press> presses;
+			for (; idx != 0; idx = nodes[idx].parent) {
+				const Node& node = nodes[idx];
+				if (node.action == Wait) continue;
+
+				// merge key held over consecutive decisions
+				if (!presses.empty() && presses[0].tick == node.ticks + 1 && presses[0].action == node.action)
+					presses.pop_front();
+				else
+					presses.push_front({ node.ticks + 1, node.action, false });
+				presses.push_front({ nodes[node.parent].ticks + 1, node.action, true });
+			};
+
+			// convert presses to events
+			Bytes::Path result;
+			size_t time = 0;
+			for (const Press& press : presses) {
+				size_t at = press.tick * 4 - 2;
+				Bytes::Event evt;
+				evt.dir = static_cast<Direction>(press.action);
+				evt.key = press.key;
+				evt.time = at - time;
+				evt.sync = false;
+				evt.moving = 0;
+				evt.waypoint = 0;
+				result.evts.push_back(evt);
+				time = at;
+			};
+			return result;
+		};
+
+		public:
+		/// Ticks to wait per wait decision.
+		size_t wait = 15;
+		/// Maximum ticks between decisions.
+		size_t settle = 600;
+		/// Estimated ticks per tile towards the exit (0 searches by ticks only).
+		/// @note Estimates ignore bumpers and moving platforms, so paths using them may not be the fastest.
+		size_t speed = 8;
+
+		/// Solver constructor.
+		/// @param data Level data.
+		/// @param threads Worker count.
+		Solver (const Bytes::Level& data, size_t threads): pool(threads) {
+			for (size_t i = 0; i < pool.size(); i++) {
+				levels.emplace_back(data);
+				levels.back().initCheckpoint();
+			};
+
+			// wait for spawn fall
+			Level::Level& level = levels[0];
+			while (level.getPlayer().act != Level::Cube::Idle && level.steps < settle)
+				level.update(Timers::step);
+
+			// store root node
+			nodes.push_back({ {}, 0, level.steps, Wait, key(level) });
+			level.save(nodes[0].data);
+			visited.insert(nodes[0].key, nodes[0].ticks);
+		};
+
+		/// Explores level states.
+		/// @param limit Maximum simulated decision count.
+		/// @return Solver result.
+		/// @note Search stops early once the fastest exit path is known and every prism is reached.
+		Result solve(size_t limit) {
+			sf::Clock clock;
+			Result result = {};
+			result.pttl = levels[0].root.prisms.size();
+
+			// mark initially collected prisms
+			std::vector<bool> reached(result.pttl, true);
+			for (uint16_t idx : prisms(levels[0]))
+				reached[idx] = false;
+
+			// search frontier ordered by ticks plus estimated ticks to the exit
+			typedef std::pair<size_t, size_t> Entry;
+			std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+			frontier.push({ nodes[0].ticks + estimate(levels[0]), 0 });
+			size_t best = -1ULL;
+
+			std::vector<std::pair<size_t, Action>> tasks;
+			std::vector<Child> children;
+			while (!frontier.empty() && result.expanded < limit) {
+				// check whether the search is complete
+				bool all = std::find(reached.begin(), reached.end(), false) == reached.end();
+				if (all && best != -1ULL && frontier.top().first >= nodes[best].ticks) break;
+
+				// take next batch
+				tasks.clear();
+				while (!frontier.empty() && tasks.size() < pool.size() * 64) {
+					size_t idx = frontier.top().second;
+					frontier.pop();
+
+					// skip states reached faster since they were queued
+					if (visited.fastest(nodes[idx].key) < nodes[idx].ticks) {
+						std::vector<uint8_t>().swap(nodes[idx].data);
+						continue;
+					};
+					for (uint8_t action = RollE; action <= Wait; action++)
+						tasks.push_back({ idx, (Action)action });
+				};
+
+				// expand batch
+				children.assign(tasks.size(), Child());
+				pool.run(tasks.size(), [this, &tasks, &children](size_t task, size_t worker) {
+					expand(nodes[tasks[task].first], tasks[task].second, levels[worker], children[task]);
+				});
+				result.expanded += tasks.size();
+				for (auto& task : tasks)
+					std::vector<uint8_t>().swap(nodes[task.first].data);
+
+				// store new states
+				for (size_t i = 0; i < tasks.size(); i++) {
+					Child& child = children[i];
+					if (!child.valid || !visited.insert(child.key, child.ticks)) continue;
+
+					// mark collected prisms
+					std::vector<bool> left(result.pttl, false);
+					for (uint16_t idx : child.left) left[idx] = true;
+					for (size_t p = 0; p < result.pttl; p++)
+						if (!left[p]) reached[p] = true;
+
+					// add node
+					nodes.push_back({ {}, tasks[i].first, child.ticks, tasks[i].second, child.key });
+					if (child.exit) {
+						if (best == -1ULL || child.ticks < nodes[best].ticks)
+							best = nodes.size() - 1;
+						continue;
+					};
+					nodes.back().data = std::move(child.data);
+					frontier.push({ child.cost, nodes.size() - 1 });
+				};
+			};
+
+			// collect results
+			result.unique = visited.size();
+			result.reach = std::count(reached.begin(), reached.end(), true);
+			result.exit = best != -1ULL;
+			if (result.exit) {
+				result.ticks = nodes[best].ticks;
+				result.path = path(best);
+			};
+			result.wall = clock.getElapsedTime().asSeconds();
+			return result;
+		};
+	};
+
+	/// Writes a path in recorder format.
+	/// @param output Output stream.
+	/// @param path Input path.
+	void print(FILE* output, const Bytes::Path& path) {
+		for (const Bytes::Event& evt : path.evts)
+			fprintf(output, "<event type=\"%s%s\" time=\"%u\"/>\n", directionName(evt.dir, true), evt.key ? "down" : "up", evt.time);
+	};
+};
@@ -2,6 +2,20 @@
 
 /// Assets namespace.
 namespace Assets {
+	/// Sound effect enumeration.
+	enum SoundEffect {
+		Cube, Minicube, Fall, Fallstop,
+		Decay, Drop, Tick, Bump,
+		Shrink, Grow, Button, Prism, Dark,
+		Exit, Select, Cancel, Ok, Start
+	};
+
+	#ifdef HEADLESS
+	/// Plays a sound effect.
+	/// @param effect Sound effect ID.
+	/// @note Headless builds have no audio output.
+	void sfx(SoundEffect effect) {};
+	#else
 	/// Sound effect namespace.
 	namespace Sound {
 		std::deque<sf::SoundBuffer> buffers;
@@ -46,14 +60,6 @@ namespace Assets {
 	/// Checks whether level title sound effect has stopped playing.
 	bool nameSfxDone() { return Sound::levelSound.getPlayingOffset() == sf::Time::Zero; };
 
-	/// Sound effect enumeration.
-	enum SoundEffect {
-		Cube, Minicube, Fall, Fallstop,
-		Decay, Drop, Tick, Bump,
-		Shrink, Grow, Button, Prism, Dark,
-		Exit, Select, Cancel, Ok, Start
-	};
-
 	/// Plays a sound effect.
 	/// @param effect Sound effect ID.
 	void sfx(SoundEffect effect) {
@@ -168,4 +174,5 @@ namespace Assets {
 			sfx.setBuffer(Sound::buffers.back());
 		};
 	};
+	#endif
 };
\ No newline at end of file
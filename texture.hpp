@@ -20,8 +20,7 @@ struct Tex {
 
 		// generate texture
 		glGenTextures(1, &ID);
-		glActiveTexture(slot);
-		glBindTexture(GL_TEXTURE_2D, ID);
+		GLState::bindTexture(slot - GL_TEXTURE0, ID);
 
 		// configure texture settings
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
@@ -31,7 +30,6 @@ struct Tex {
 
 		// upload texture data
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, img.getSize().x, img.getSize().y, 0, GL_RGBA, GL_UNSIGNED_BYTE, img.getPixelsPtr());
-		glBindTexture(GL_TEXTURE_2D, 0);
 	};
 
 	/// Uses texture slot for rendering.
@@ -40,19 +38,14 @@ struct Tex {
 	/// @param unit Texture unit slot.
 	static void useSlot(Shader& shader, const char* name, GLuint unit) {
 		shader.use();
-		GLuint uniform = glGetUniformLocation(shader.ID, name);
-		glUniform1i(uniform, unit);
+		glUniform1i(shader.at(name), unit);
 	};
 
 	/// Binds texture.
-	void bind () const {
-		static GLuint last = -1;
-		if (last != ID)
-			glBindTexture(GL_TEXTURE_2D, last = ID);
-	};
+	void bind  () const { GLState::bindTexture(0, ID); };
 	/// Unbinds texture.
-	void unbind() const { glBindTexture(GL_TEXTURE_2D, 0 ); };
+	void unbind() const { GLState::bindTexture(0, 0 ); };
 
 	/// Deallocates texture.
-	~Tex () { glDeleteTextures(1, &ID); };
+	~Tex () { GLState::dropTexture(ID); glDeleteTextures(1, &ID); };
 };
\ No newline at end of file
@@ -67,6 +67,36 @@ namespace Timers {
 	/// Darkcube rainbow timer.
 	Timer darkcube(10000, 0x80);
 
+	/// Fixed simulation step length.
+	/// @note Equals 4 level ticks, since cube motion advances by a fixed amount each step.
+	const float step = 1.0f / 60;
+
+	/// Maximum simulation steps per frame.
+	const uint32_t maxSteps = 8;
+
+	/// Unsimulated frame time.
+	float accumulator = 0.0f;
+
+	/// Accumulates frame time into fixed simulation steps.
+	/// @param delta Elapsed time since last frame.
+	/// @return Amount of simulation steps to run.
+	/// @note If a frame takes too long, leftover time is dropped to avoid a spiral of death.
+	uint32_t steps(float delta) {
+		accumulator += delta;
+
+		// count whole steps
+		uint32_t count = (uint32_t)(accumulator / step);
+		if (count > maxSteps) {
+			accumulator = 0.0f;
+			return maxSteps;
+		};
+		accumulator -= count * step;
+		return count;
+	};
+
+	/// Returns progress towards the next simulation step in [0, 1].
+	float alpha() { return glm::clamp(accumulator / step, 0.0f, 1.0f); };
+
 	/// Update all timers.
 	/// @param uiOnly Whether to update only UI timers.
 	float update(bool uiOnly) {
@@ -92,6 +122,11 @@ namespace Timers {
 
 /// Rainbow color processing namespace.
 namespace Rainbow {
+	/// Rainbow table rows of cube & prism X, Y & Z faces.
+	const glm::ivec3 cubeRows = glm::ivec3(1, 2, 0);
+	/// Rainbow table rows of dark cube & dark prism X, Y & Z faces.
+	const glm::ivec3 darkRows = glm::ivec3(4, 5, 3);
+
 	/// Returns rainbow dust color.
 	/// @param off Color offset.
 	/// @param mode Color mode.
@@ -109,69 +144,12 @@ namespace Rainbow {
 	/// @param off Color offset.
 	glm::vec3 textFast(uint8_t off) { return Assets::rainbow[2][Timers::textFast.value(off)]; };
 
-	/// Returns a resizer color.
-	glm::vec3 resizerA() { return Assets::rainbow[1][Timers::mid.value(0x00)]; };
-	/// Returns an alt resizer color.
-	glm::vec3 resizerB() { return Assets::rainbow[1][Timers::mid.value(0xF8)]; };
-
 	/// Returns a helper color.
 	glm::vec3 helper() { return Assets::rainbow[2][Timers::slow.value(0x60)]; };
 
-	/// Returns an exit color.
-	glm::vec3 exitA() { return Assets::rainbow[2][Timers::slow.value(0x40)]; };
-	/// Returns an alt exit color.
-	glm::vec3 exitB() { return Assets::rainbow[2][Timers::slow.value(0xC0)]; };
-
 	/// Returns moving platform highlight color.
 	glm::vec3 moving() { return Assets::rainbow[0][Timers::fast.value(0x80)]; };
 
-	/// Returns prism dark side face color.
-	glm::vec3 prismX() { return Assets::rainbow[1][Timers::fast.value()]; };
-	/// Returns prism top face color.
-	glm::vec3 prismY() { return Assets::rainbow[2][Timers::fast.value()]; };
-	/// Returns prism light side face color.
-	glm::vec3 prismZ() { return Assets::rainbow[0][Timers::fast.value()]; };
-
-	/// Returns current cube dark side face color.
-	glm::vec3 cubeX(bool dynamic) { return Assets::rainbow[1][(dynamic ? Timers::cube : Timers::darkcube).value()]; };
-	/// Returns current cube top face color.
-	glm::vec3 cubeY(bool dynamic) { return Assets::rainbow[2][(dynamic ? Timers::cube : Timers::darkcube).value()]; };
-	/// Returns current cube light side face color.
-	glm::vec3 cubeZ(bool dynamic) { return Assets::rainbow[0][(dynamic ? Timers::cube : Timers::darkcube).value()]; };
-
-	/// Returns gradient from dark side face to top face color.
-	/// @param t Gradient progress.
-	glm::vec3 gradXY(bool dynamic, float t) { return lerpv(cubeX(dynamic), cubeY(dynamic), t); };
-	/// Returns gradient from top face to dark side face color.
-	/// @param t Gradient progress.
-	glm::vec3 gradYX(bool dynamic, float t) { return lerpv(cubeY(dynamic), cubeX(dynamic), t); };
-	/// Returns gradient from light side face to top face color.
-	/// @param t Gradient progress.
-	glm::vec3 gradZY(bool dynamic, float t) { return lerpv(cubeZ(dynamic), cubeY(dynamic), t); };
-	/// Returns gradient from top face to light side face color.
-	/// @param t Gradient progress.
-	glm::vec3 gradYZ(bool dynamic, float t) { return lerpv(cubeY(dynamic), cubeZ(dynamic), t); };
-
-	/// Returns dark prism dark side face color.
-	glm::vec3 darkPrismX() { return Assets::rainbow[4][Timers::fast.value()]; };
-	/// Returns dark prism top face color.
-	glm::vec3 darkPrismY() { return Assets::rainbow[5][Timers::fast.value()]; };
-	/// Returns dark prism light side face color.
-	glm::vec3 darkPrismZ() { return Assets::rainbow[3][Timers::fast.value()]; };
-
-	/// Returns dark gradient from dark side face to top face color.
-	/// @param t Gradient progress.
-	glm::vec3 darkGradXY(float t) { return lerpv(darkPrismX(), darkPrismY(), t); };
-	/// Returns dark gradient from top face to dark side face color.
-	/// @param t Gradient progress.
-	glm::vec3 darkGradYX(float t) { return lerpv(darkPrismY(), darkPrismX(), t); };
-	/// Returns dark gradient from light side face to top face color.
-	/// @param t Gradient progress.
-	glm::vec3 darkGradZY(float t) { return lerpv(darkPrismZ(), darkPrismY(), t); };
-	/// Returns dark gradient from top face to light side face color.
-	/// @param t Gradient progress.
-	glm::vec3 darkGradYZ(float t) { return lerpv(darkPrismY(), darkPrismZ(), t); };
-
 	/// Returns color glint.
 	/// @param off Rainbow offset.
 	float glint(uint8_t off) {
@@ -18,7 +18,7 @@ char directionChar(Direction dir) {
 const char* directionName(Direction dir, bool lower = false) {
 	static const char* const table[2][4] {
 		{ "East", "West", "North", "South" },
-		{ "east", "west", "north", "South" },
+		{ "east", "west", "north", "south" },
 	};
 	return (dir >= East && dir <= South) ? table[lower][dir] : "Unknown";
 };
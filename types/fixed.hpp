@@ -169,6 +169,10 @@ class fix {
 		inline fix ceil() const { return (*this + raw(0xFFFFFFFFULL)).floor(); };
 		/// Returns number rounded to nearest integer.
 		inline fix round() const { return (*this + raw(0x80000000ULL)).floor(); };
+		/// Returns number rounded to nearest multiple of a binary fraction.
+		/// @param bits Fraction bit count.
+		/// @note Equals `(n * (1 << bits)).round() / (1 << bits)` without the division.
+		inline fix round(int bits) const { return raw((val + (0x80000000LL >> bits)) & ~((0x100000000LL >> bits) - 1)); };
 		/// Returns number quotient value.
 		inline fix quo() const { return raw(val & 0xFFFFFFFFULL); };
 		/// Returns integer part of the number.
@@ -286,6 +286,9 @@ namespace UI {
 				// update star system
 				stars.update(delta);
 
+				// get simulation step count
+				uint32_t steps = Timers::steps(delta);
+
 				// update loading screen
 				if (state == GameLoad) {
 					// generate gamemap transition
@@ -301,9 +304,10 @@ namespace UI {
 							isPaused = false;
 							canPause = true;
 
-							// tick game map
-							gamemap->update(0.0f);
+							// prepare game map view
+							gamemap->refresh();
 							gamemap->follow(glm::vec3(0.0f));
+							gamemap->look();
 
 							// hide world menu elements
 							wall->active = false;
@@ -325,20 +329,26 @@ namespace UI {
 
 				// update game map
 				if (gamemap && drawGameMap()) {
-					// update game state
-					if (state != GameLoad && !isPaused) gamemap->update(delta);
-
-					// update camera position
-					if (state == GameMap)
-						gamemap->follow(isPaused ? pause->cameraOffset(gamemap->camera) : glm::vec3(0.0f));
-					else if (state == GameExit)
-						gamemap->follow(comp->cameraOffset(gamemap->camera));
+					for (uint32_t i = 0; i < steps; i++) {
+						// update game state
+						if (state != GameLoad && !isPaused && Win::updates) gamemap->update(Timers::step);
+
+						// update camera position
+						if (state == GameMap)
+							gamemap->follow(isPaused ? pause->cameraOffset(gamemap->camera) : glm::vec3(0.0f));
+						else if (state == GameExit)
+							gamemap->follow(comp->cameraOffset(gamemap->camera));
+					};
+					gamemap->look(isPaused ? 1.0f : Timers::alpha());
 				};
 
 				// update world map
 				if (worldmap && drawWorldMap()) {
 					// update world state
-					worldmap->update(delta, debug);
+					if (Win::updates) {
+						for (uint32_t i = 0; i < steps; i++)
+							worldmap->update(Timers::step, debug);
+					};
 
 					// check for world map exit
 					if (worldmap->getPlayer().act == Level::Cube::Exit) {
@@ -392,14 +402,17 @@ namespace UI {
 					};
 
 					// update camera position
-					if (state == WorldMap)
-						worldmap->follow(world_mgr->cameraOffset(worldmap->camera));
-					else
-						worldmap->follow(glm::vec3(0.0f));
+					for (uint32_t i = 0; i < steps; i++) {
+						if (state == WorldMap)
+							worldmap->follow(world_mgr->cameraOffset(worldmap->camera));
+						else
+							worldmap->follow(glm::vec3(0.0f));
+					};
+					worldmap->look(Timers::alpha());
 				};
 
 				// update recorder
-				recorder.update(delta);
+				recorder.update(steps * Timers::step);
 			});
 
 			// animation update callback
@@ -570,6 +583,17 @@ namespace UI {
 					};
 				};
 
+				// rewind game map by a second
+				if (data.key == sf::Keyboard::Backspace) {
+					if (gamemap && state == GameMap) {
+						size_t ticks = gamemap->rewind(1.0f / Timers::step);
+						notifs->push(Notif::Once([=](Text& text) {
+							text.setFmt("\2Rewound <\6%d\7> ticks.", ticks);
+						}));
+						return true;
+					};
+				};
+
 				// bind recorder
 				if (data.key == sf::Keyboard::Insert) {
 					if (worldmap && state == WorldMap) {
@@ -677,8 +701,7 @@ namespace UI {
 			label_info->emitHide(anims);
 			cubeAnim = true;
 			nextAnim = false;
-			worldmap->getPlayer().keys
-				= Level::KeyMap(&world.routedata.routes[world_mgr->selected].path);
+			worldmap->drive(&world.routedata.routes[world_mgr->selected].path);
 			world_mgr->ignore = true;
 
 			// reset camera triggers
@@ -760,6 +783,7 @@ namespace UI {
 			gamemap = std::unique_ptr<Level::Level>(new Level::Level(data, false));
 			gamemap->model();
 			gamemap->initCheckpoint();
+			gamemap->timeline = Level::Rewind(Level::rewindBudget);
 			addMusic(gamemap->root.mus, gamemap.get());
 
 			// create new game UI elements
@@ -1075,6 +1099,8 @@ namespace UI {
 		void drawSelf(sf::IntRect self) const override {
 			// reset render stats
 			UI::sprite_count = 0;
+			GLState::clearCounters();
+			RenderQueue::clearCounters();
 			Debug::vert_normal = 0;
 			Debug::vert_shadow = 0;
 
@@ -1082,20 +1108,28 @@ namespace UI {
 			Win::clear();
 
 			// draw stars
-			glDisable(GL_DEPTH_TEST);
+			GLState::toggle(GLState::Depth, false);
 			stars.draw(self);
-			glEnable(GL_DEPTH_TEST);
+			GLState::toggle(GLState::Depth, true);
 
 			// draw game map
 			if (drawGameMap() && gamemap) {
-				Debug::vert_normal += gamemap->draw();   Win::buffer();
-				Debug::vert_shadow += gamemap->shadow(); Win::shadow();
+				float alpha = isPaused ? 1.0f : Timers::alpha();
+				Debug::terrain_faces = gamemap->terrain.faces();
+				Debug::terrain_quads = gamemap->terrain.quads();
+				Debug::vert_normal += gamemap->draw(alpha);
+				Debug::vert_shadow += gamemap->shadow(alpha);
+				RenderQueue::execute(RenderQueue::Color);  Win::buffer();
+				RenderQueue::execute(RenderQueue::Shadow); Win::shadow();
 			};
 
 			// draw world map
 			if (drawWorldMap() && worldmap) {
-				Debug::vert_normal += worldmap->draw();   Win::buffer();
-				Debug::vert_shadow += worldmap->shadow(); Win::shadow();
+				float alpha = Timers::alpha();
+				Debug::vert_normal += worldmap->draw(alpha);
+				Debug::vert_shadow += worldmap->shadow(alpha);
+				RenderQueue::execute(RenderQueue::Color);  Win::buffer();
+				RenderQueue::execute(RenderQueue::Shadow); Win::shadow();
 			};
 
 			// start drawing GUI
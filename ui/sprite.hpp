@@ -29,6 +29,8 @@ namespace UI {
 
 		/// Vertex buffer object.
 		VertexBuffer m_buffer;
+		/// Vertex index buffer object.
+		IndexBuffer m_elements;
 		/// Vertex layout object.
 		VertexLayout m_layout;
 
@@ -49,6 +51,7 @@ namespace UI {
 			m_layout.link(0, 2, GL_FLOAT, 4 * sizeof(GL_FLOAT), 0 * sizeof(GL_FLOAT));
 			m_layout.link(1, 2, GL_FLOAT, 4 * sizeof(GL_FLOAT), 2 * sizeof(GL_FLOAT));
 			m_layout.count = 4;
+			m_elements.reset(m_inds, lengthof(m_inds));
 			m_layout.unbind();
 
 			// generate empty buffer
@@ -84,9 +87,9 @@ namespace UI {
 			Shaders::gui.use();
 
 			// get uniform locations
-			static GLuint uf_translate = glGetUniformLocation(Shaders::gui.ID, "translate");
-			static GLuint uf_transform = glGetUniformLocation(Shaders::gui.ID, "transform");
-			static GLuint uf_color = glGetUniformLocation(Shaders::gui.ID, "color");
+			static GLint uf_translate = Shaders::gui.at("translate");
+			static GLint uf_transform = Shaders::gui.at("transform");
+			static GLint uf_color = Shaders::gui.color;
 
 			// update sprite translation
 			glm::vec2 pos = glm::vec2((float)this->pos.x, (float)this->pos.y);
@@ -103,7 +106,7 @@ namespace UI {
 			glUniform4fv(uf_color, 1, glm::value_ptr(full));
 
 			// draw sprite
-			m_layout.drawIndex(m_inds, lengthof(m_inds));
+			m_layout.drawIndex(m_elements.count);
 			sprite_count++;
 		};
 	};
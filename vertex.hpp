@@ -38,6 +38,34 @@ struct Vertex {
 	/// Returns `float` pointer to vertex data.
 	float* data() const { return (float*)this; };
 };
+static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex data must be tightly packed");
+
+/// Packed vertex object.
+/// @note Position is stored in fixed point `unit` steps, so packed models must stay within 32 units of their origin.
+/// @note Color and texture UV are stored normalized, so their components are clamped into `[0, 1]` range.
+struct PackedVertex {
+	int16_t  pos[4]; /// Vertex position (last component is padding).
+	uint8_t  col[4]; /// Vertex color (last component is padding).
+	uint16_t tex[2]; /// Vertex texture UV.
+
+	/// Position fixed point step.
+	static constexpr float unit = 1.0f / 1024;
+
+	/// Default empty constructor.
+	PackedVertex () {};
+	/// Packs a vertex.
+	/// @param vert Source vertex.
+	PackedVertex (const Vertex& vert) {
+		for (int i = 0; i < 3; i++) {
+			pos[i] = (int16_t)glm::clamp(roundf(vert.pos[i] / unit), -32768.0f, 32767.0f);
+			col[i] = (uint8_t)roundf(glm::clamp(vert.col[i], 0.0f, 1.0f) * 255.0f);
+		};
+		for (int i = 0; i < 2; i++)
+			tex[i] = (uint16_t)roundf(glm::clamp(vert.tex[i], 0.0f, 1.0f) * 65535.0f);
+		pos[3] = 0;
+		col[3] = 0;
+	};
+};
 
 /// Vertex buffer object.
 struct VertexBuffer {
@@ -54,16 +82,24 @@ struct VertexBuffer {
 	/// @param usage Buffer usage type.
 	VertexBuffer (const float* vertices, GLsizeiptr size, GLenum usage): size(size), usage(usage) {
 		glGenBuffers(1, &ID);
-		glBindBuffer(GL_ARRAY_BUFFER, ID);
+		GLState::bindBuffer(ID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, usage);
 	};
 
 	/// Substitutes vertex buffer data.
 	/// @param vertices Vertex data pointer.
 	void sub(const float* vertices) const {
-		glBindBuffer(GL_ARRAY_BUFFER, ID);
+		GLState::bindBuffer(ID);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
+	};
+
+	/// Streams vertex buffer data.
+	/// @param vertices Vertex data pointer.
+	/// @note Previous buffer storage is orphaned, so the upload does not wait for draws still reading it.
+	void stream(const float* vertices) const {
+		GLState::bindBuffer(ID);
+		glBufferData(GL_ARRAY_BUFFER, size, NULL, usage);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	};
 
 	/// Allocates a new vertex buffer.
@@ -71,18 +107,42 @@ struct VertexBuffer {
 	/// @param size Vertex data size.
 	void reset(const float* vertices, GLsizeiptr size) {
 		this->size = size;
-		glBindBuffer(GL_ARRAY_BUFFER, ID);
+		GLState::bindBuffer(ID);
 		glBufferData(GL_ARRAY_BUFFER, size, vertices, usage);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	};
 
 	/// Binds vertex buffer.
-	void bind  () const { glBindBuffer(GL_ARRAY_BUFFER, ID); };
+	void bind  () const { GLState::bindBuffer(ID); };
 	/// Unbinds vertex buffer.
-	void unbind() const { glBindBuffer(GL_ARRAY_BUFFER, 0 ); };
+	void unbind() const { GLState::bindBuffer(0 ); };
 
 	/// Deallocates vertex buffer.
-	~VertexBuffer () { glDeleteBuffers(1, &ID); };
+	~VertexBuffer () { GLState::dropBuffer(ID); glDeleteBuffers(1, &ID); };
+};
+
+/// Vertex index buffer object.
+/// @note Index buffer binding is stored in the vertex layout bound during upload.
+struct IndexBuffer {
+	/// Index buffer ID.
+	GLuint ID;
+	/// Index count.
+	GLsizei count;
+
+	/// Empty index buffer constructor.
+	IndexBuffer (): count(0) { glGenBuffers(1, &ID); };
+
+	/// Uploads vertex indices.
+	/// @param indices Index data pointer.
+	/// @param count Index count.
+	/// @warning Vertex layout using the indices must be bound.
+	void reset(const GLuint* indices, GLsizei count) {
+		this->count = count;
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * count, indices, GL_STATIC_DRAW);
+	};
+
+	/// Deallocates index buffer.
+	~IndexBuffer () { glDeleteBuffers(1, &ID); };
 };
 
 /// Vertex buffer layout.
@@ -107,33 +167,46 @@ struct VertexLayout {
 	/// @param type Data type.
 	/// @param stride Layout block size.
 	/// @param offset Layout block offset.
-	void link(GLuint loc, GLuint width, GLenum type, GLsizeiptr stride, GLsizeiptr offset) const {
-		glVertexAttribPointer(loc, width, type, GL_FALSE, stride, (void*)offset);
+	/// @param norm Whether integer data is normalized into `[0, 1]` range.
+	void link(GLuint loc, GLuint width, GLenum type, GLsizeiptr stride, GLsizeiptr offset, GLboolean norm = GL_FALSE) const {
+		glVertexAttribPointer(loc, width, type, norm, stride, (void*)offset);
 		glEnableVertexAttribArray(loc);
 	};
 
 	/// Draws buffer as vertices.
 	/// @return Drawn vertex count.
+	/// @note Layout stays bound, so repeated draws skip rebinding.
 	size_t draw() const {
-		glBindVertexArray(ID);
+		GLState::bindLayout(ID);
 		glDrawArrays(prim, 0, count);
-		glBindVertexArray(0);
 		return count;
 	};
 
-	/// Draws buffer with index buffer.
-	size_t drawIndex(const GLuint* indices, GLsizeiptr count) const {
-		glBindVertexArray(ID);
-		glDrawElements(prim, count, GL_UNSIGNED_INT, indices);
-		glBindVertexArray(0);
+	/// Draws buffer with attached index buffer.
+	/// @param count Drawn index count.
+	/// @return Drawn vertex count.
+	/// @note Layout stays bound, so repeated draws skip rebinding.
+	size_t drawIndex(GLsizeiptr count) const {
+		GLState::bindLayout(ID);
+		glDrawElements(prim, count, GL_UNSIGNED_INT, (void*)0);
 		return count;
 	};
 
+	/// Draws multiple instances of buffer with attached index buffer.
+	/// @param count Drawn index count.
+	/// @param instances Instance count.
+	/// @return Drawn vertex count.
+	size_t drawInstances(GLsizeiptr count, GLsizei instances) const {
+		GLState::bindLayout(ID);
+		glDrawElementsInstanced(prim, count, GL_UNSIGNED_INT, (void*)0, instances);
+		return count * instances;
+	};
+
 	/// Binds vertex layout.
-	void bind  () const { glBindVertexArray(ID); };
+	void bind  () const { GLState::bindLayout(ID); };
 	/// Unbinds vertex layout.
-	void unbind() const { glBindVertexArray(0 ); };
+	void unbind() const { GLState::bindLayout(0 ); };
 
 	/// Deallocates vertex layout.
-	~VertexLayout () { glDeleteVertexArrays(1, &ID); };
+	~VertexLayout () { GLState::dropLayout(ID); glDeleteVertexArrays(1, &ID); };
 };
\ No newline at end of file
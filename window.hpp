@@ -17,11 +17,9 @@ namespace Win {
 	/// Whether the game should be updating.
 	bool updates = true;
 
-	/// Sends window size to GUI shader.
+	/// Sends window size to shaders.
 	void sendWindowSize() {
-		Shaders::gui.use();
-		glUniform1ui(glGetUniformLocation(Shaders::gui.ID, "winX"), size.x);
-		glUniform1ui(glGetUniformLocation(Shaders::gui.ID, "winY"), size.y);
+		Shaders::sendWindow(glm::uvec2(size.x, size.y));
 	};
 
 	/// Creates a new window instance.
@@ -90,17 +88,20 @@ namespace Win {
 
 	/// Initializes OpenGL.
 	void init() {
+		// forget cached state
+		GLState::reset();
+
 		// enable depth testing
-		glEnable(GL_DEPTH_TEST);
+		GLState::toggle(GLState::Depth, true);
 		glDepthFunc(GL_LEQUAL);
 
 		// enable face culling
-		glEnable(GL_CULL_FACE);
+		GLState::toggle(GLState::Cull, true);
 		glCullFace(GL_BACK);
 		glFrontFace(GL_CCW);
 
 		// enable alpha blending
-		glEnable(GL_BLEND);
+		GLState::toggle(GLState::Blend, true);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 	};
 
@@ -111,28 +112,27 @@ namespace Win {
 		sendWindowSize();
 
 		// clear buffer
-		glDisable(GL_STENCIL_TEST);
-		glEnable(GL_DEPTH_TEST);
+		GLState::toggle(GLState::Stencil, false);
+		GLState::toggle(GLState::Depth, true);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
 		// draw background
-		glDepthMask(0);
+		GLState::depthWrite(false);
 		Models::Space::draw();
-		glDepthMask(1);
+		GLState::depthWrite(true);
 	};
 
 	/// Enables shadow buffering mode.
 	void buffer() {
 		// enable stencil testing
-		glEnable(GL_STENCIL_TEST);
+		GLState::toggle(GLState::Stencil, true);
 		glStencilFunc(GL_ALWAYS, 0, ~0);
-		glColorMask(0, 0, 0, 0);
-		glDepthMask(0);
+		GLState::colorWrite(false);
+		GLState::depthWrite(false);
 		glStencilMask(~0);
-		glDepthMask(GL_FALSE);
 
 		// setup shadow stencils
-		glDisable(GL_CULL_FACE);
+		GLState::toggle(GLState::Cull, false);
 		glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
 		glStencilOpSeparate(GL_BACK , GL_KEEP, GL_KEEP, GL_DECR_WRAP);
 	};
@@ -140,9 +140,9 @@ namespace Win {
 	/// Draws shadow buffer.
 	/// @param space Shadow mask object.
 	void shadow() {
-		glEnable(GL_CULL_FACE);
-		glColorMask(1, 1, 1, 1);
-		glDepthMask(1);
+		GLState::toggle(GLState::Cull, true);
+		GLState::colorWrite(true);
+		GLState::depthWrite(true);
 		glStencilFunc(GL_NOTEQUAL, 0, ~0);
 		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 		Models::Space::shadow();
@@ -150,7 +150,7 @@ namespace Win {
 
 	/// Prepare for GUI rendering.
 	void gui() {
-		glDisable(GL_DEPTH_TEST);
-		glDisable(GL_STENCIL_TEST);
+		GLState::toggle(GLState::Depth, false);
+		GLState::toggle(GLState::Stencil, false);
 	};
 };
\ No newline at end of file